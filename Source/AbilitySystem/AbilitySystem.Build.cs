@@ -38,12 +38,17 @@ public class AbilitySystem : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
-				"NetCore"
+				"NetCore",
+				"AIModule",
+				"AssetRegistry"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
 		
 		
+		// Defines UE_WITH_IRIS and adds IrisCore when the target is built with Iris
+		SetupIrisSupport(Target);
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -1,12 +1,20 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AbilitySystem.h"
 
+#include "Misc/CoreDelegates.h"
+#include "Objects/ASClassRegistry.h"
+
 #define LOCTEXT_NAMESPACE "FAbilitySystemModule"
 
+DEFINE_LOG_CATEGORY(LogAbilitySystem);
+
 void FAbilitySystemModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// Blueprint classes are known once the asset registry has been loaded
+	FCoreDelegates::OnPostEngineInit.AddStatic(&FASClassRegistry::Build);
 }
 
 void FAbilitySystemModule::ShutdownModule()
@@ -0,0 +1,94 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Async/ASAsyncAction.h"
+
+#include "Components/ASComponent.h"
+#include "GameFramework/Actor.h"
+
+void UASAsyncAction::Init(UASComponent* InComponent, bool bInTriggerOnce)
+{
+	Component = InComponent;
+	bTriggerOnce = bInTriggerOnce;
+
+	if (InComponent)
+	{
+		RegisterWithGameInstance(InComponent);
+	}
+}
+
+void UASAsyncAction::Activate()
+{
+	Super::Activate();
+
+	UASComponent* asComp = Component.Get();
+	AActor* owner = asComp ? asComp->GetOwner() : nullptr;
+	if (!IsValid(owner))
+	{
+		SetReadyToDestroy();
+		return;
+	}
+
+	bWaiting = true;
+	owner->OnDestroyed.AddDynamic(this, &UASAsyncAction::HandleOwnerDestroyed);
+	BindEvents(asComp);
+}
+
+void UASAsyncAction::SetReadyToDestroy()
+{
+	if (bWaiting)
+	{
+		bWaiting = false;
+
+		UASComponent* asComp = Component.Get();
+		if (asComp)
+		{
+			if (AActor* owner = asComp->GetOwner())
+			{
+				owner->OnDestroyed.RemoveDynamic(this, &UASAsyncAction::HandleOwnerDestroyed);
+			}
+		}
+		UnbindEvents(asComp);
+	}
+
+	Super::SetReadyToDestroy();
+}
+
+void UASAsyncAction::Cancel()
+{
+	SetReadyToDestroy();
+}
+
+void UASAsyncAction::OnTriggered()
+{
+	if (bTriggerOnce)
+	{
+		SetReadyToDestroy();
+	}
+}
+
+void UASAsyncAction::HandleOwnerDestroyed(AActor* InActor)
+{
+	SetReadyToDestroy();
+}
+
+bool UASAsyncAction::Compare(float InValue, EASAsyncComparison InComparison, float InThreshold)
+{
+	switch (InComparison)
+	{
+	case EASAsyncComparison::Less:
+		return InValue < InThreshold;
+	case EASAsyncComparison::LessOrEqual:
+		return InValue <= InThreshold;
+	case EASAsyncComparison::Greater:
+		return InValue > InThreshold;
+	case EASAsyncComparison::GreaterOrEqual:
+		return InValue >= InThreshold;
+	case EASAsyncComparison::Equal:
+		return FMath::IsNearlyEqual(InValue, InThreshold);
+	case EASAsyncComparison::NotEqual:
+		return !FMath::IsNearlyEqual(InValue, InThreshold);
+	default:
+		return false;
+	}
+}
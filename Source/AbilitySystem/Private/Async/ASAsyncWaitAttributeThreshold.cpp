@@ -0,0 +1,135 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Async/ASAsyncWaitAttributeThreshold.h"
+
+#include "Components/ASComponent.h"
+#include "Objects/Attribute.h"
+
+UASAsyncWaitAttributeThreshold* UASAsyncWaitAttributeThreshold::WaitAttributeThreshold(UASComponent* Component,
+	TSubclassOf<UAttribute> AttributeClass, EASAsyncComparison Comparison, float Threshold, bool bAsPercentOfMax,
+	bool bTriggerOnce)
+{
+	UASAsyncWaitAttributeThreshold* action = NewObject<UASAsyncWaitAttributeThreshold>();
+	action->AttributeClass = AttributeClass;
+	action->Comparison = Comparison;
+	action->Threshold = Threshold;
+	action->bAsPercentOfMax = bAsPercentOfMax;
+	action->Init(Component, bTriggerOnce);
+	return action;
+}
+
+void UASAsyncWaitAttributeThreshold::BindEvents(UASComponent* InComponent)
+{
+	FASComponentNativeEvents& events = InComponent->GetNativeEvents();
+	events.AttributeAdded.AddUObject(this, &UASAsyncWaitAttributeThreshold::HandleAttributeAdded);
+	events.AttributeRemoved.AddUObject(this, &UASAsyncWaitAttributeThreshold::HandleAttributeRemoved);
+	events.AttributeListUpdated.AddUObject(this, &UASAsyncWaitAttributeThreshold::HandleAttributeListChanged);
+
+	BindAttribute(InComponent);
+}
+
+void UASAsyncWaitAttributeThreshold::UnbindEvents(UASComponent* InComponent)
+{
+	UnbindAttribute();
+
+	if (InComponent && InComponent->HasNativeEvents())
+	{
+		FASComponentNativeEvents& events = InComponent->GetNativeEvents();
+		events.AttributeAdded.RemoveAll(this);
+		events.AttributeRemoved.RemoveAll(this);
+		events.AttributeListUpdated.RemoveAll(this);
+	}
+}
+
+void UASAsyncWaitAttributeThreshold::BindAttribute(UASComponent* InComponent, UAttribute* InRemoving)
+{
+	UAttribute* attribute = InComponent->Attribute(AttributeClass);
+	if (attribute == InRemoving)
+	{
+		attribute = nullptr;
+	}
+
+	if (attribute == BoundAttribute.Get())
+		return;
+
+	UnbindAttribute();
+
+	if (attribute)
+	{
+		BoundAttribute = attribute;
+
+		FASAttributeNativeEvents& events = attribute->GetNativeEvents();
+		events.ValueChanged.AddUObject(this, &UASAsyncWaitAttributeThreshold::HandleValueChanged);
+		if (bAsPercentOfMax)
+		{
+			events.MaxValueChanged.AddUObject(this, &UASAsyncWaitAttributeThreshold::HandleValueChanged);
+		}
+
+		Evaluate();
+	}
+}
+
+void UASAsyncWaitAttributeThreshold::UnbindAttribute()
+{
+	if (UAttribute* attribute = BoundAttribute.Get())
+	{
+		if (attribute->HasNativeEvents())
+		{
+			FASAttributeNativeEvents& events = attribute->GetNativeEvents();
+			events.ValueChanged.RemoveAll(this);
+			events.MaxValueChanged.RemoveAll(this);
+		}
+	}
+	BoundAttribute.Reset();
+}
+
+void UASAsyncWaitAttributeThreshold::Evaluate()
+{
+	const UAttribute* attribute = BoundAttribute.Get();
+	if (!attribute || !IsWaiting())
+		return;
+
+	const float current = attribute->GetCurrentValue();
+	float value = current;
+	if (bAsPercentOfMax)
+	{
+		const float max = attribute->GetMaxValue();
+		value = FMath::IsNearlyZero(max) ? 0.0f : current / max;
+	}
+
+	const bool bSatisfied = Compare(value, Comparison, Threshold);
+	if (bSatisfied == bReached)
+		return;
+
+	bReached = bSatisfied;
+	if (bSatisfied)
+	{
+		OnThresholdReached.Broadcast(current);
+		OnTriggered();
+	}
+	else
+	{
+		OnThresholdLeft.Broadcast(current);
+	}
+}
+
+void UASAsyncWaitAttributeThreshold::HandleAttributeListChanged(UASComponent* InComponent)
+{
+	BindAttribute(InComponent);
+}
+
+void UASAsyncWaitAttributeThreshold::HandleAttributeAdded(UASComponent* InComponent, UAttribute* InAttribute)
+{
+	BindAttribute(InComponent);
+}
+
+void UASAsyncWaitAttributeThreshold::HandleAttributeRemoved(UASComponent* InComponent, UAttribute* InAttribute)
+{
+	BindAttribute(InComponent, InAttribute);
+}
+
+void UASAsyncWaitAttributeThreshold::HandleValueChanged(UAttribute* InAttribute, float InValue)
+{
+	Evaluate();
+}
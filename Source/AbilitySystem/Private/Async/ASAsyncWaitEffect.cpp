@@ -0,0 +1,107 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Async/ASAsyncWaitEffect.h"
+
+#include "Components/ASComponent.h"
+#include "Objects/Effects/Effect.h"
+
+UASAsyncWaitEffect* UASAsyncWaitEffect::WaitEffectAdded(UASComponent* Component, TSubclassOf<UEffect> EffectClass,
+                                                        bool bTriggerIfAlreadyPresent, bool bTriggerOnce)
+{
+	UASAsyncWaitEffect* action = NewObject<UASAsyncWaitEffect>();
+	action->EffectClass = EffectClass;
+	action->bWaitForRemoval = false;
+	action->bTriggerOnStart = bTriggerIfAlreadyPresent;
+	action->Init(Component, bTriggerOnce);
+	return action;
+}
+
+UASAsyncWaitEffect* UASAsyncWaitEffect::WaitEffectRemoved(UASComponent* Component, TSubclassOf<UEffect> EffectClass,
+                                                          bool bTriggerIfNotPresent, bool bTriggerOnce)
+{
+	UASAsyncWaitEffect* action = NewObject<UASAsyncWaitEffect>();
+	action->EffectClass = EffectClass;
+	action->bWaitForRemoval = true;
+	action->bTriggerOnStart = bTriggerIfNotPresent;
+	action->Init(Component, bTriggerOnce);
+	return action;
+}
+
+void UASAsyncWaitEffect::BindEvents(UASComponent* InComponent)
+{
+	UEffect* effect = InComponent->Effect(EffectClass);
+	PresentEffect = effect;
+	bPresent = effect != nullptr;
+
+	// Initial state counts as a transition only if requested
+	const bool bMatches = bWaitForRemoval ? effect == nullptr : effect != nullptr;
+	if (bMatches && bTriggerOnStart)
+	{
+		OnChanged.Broadcast(effect);
+		OnTriggered();
+		if (!IsWaiting())
+			return;
+	}
+
+	FASComponentNativeEvents& events = InComponent->GetNativeEvents();
+	events.EffectAdded.AddUObject(this, &UASAsyncWaitEffect::HandleEffectAdded);
+	events.EffectRemoved.AddUObject(this, &UASAsyncWaitEffect::HandleEffectRemoved);
+	events.EffectListUpdated.AddUObject(this, &UASAsyncWaitEffect::HandleEffectListChanged);
+}
+
+void UASAsyncWaitEffect::UnbindEvents(UASComponent* InComponent)
+{
+	if (InComponent && InComponent->HasNativeEvents())
+	{
+		FASComponentNativeEvents& events = InComponent->GetNativeEvents();
+		events.EffectAdded.RemoveAll(this);
+		events.EffectRemoved.RemoveAll(this);
+		events.EffectListUpdated.RemoveAll(this);
+	}
+}
+
+void UASAsyncWaitEffect::Evaluate(UASComponent* InComponent, UEffect* InRemoving)
+{
+	UEffect* effect = InComponent->Effect(EffectClass);
+	if (effect == InRemoving)
+	{
+		effect = nullptr;
+	}
+
+	// The previous effect may already be destroyed on clients
+	UEffect* previous = PresentEffect.Get();
+	const bool bWasPresent = bPresent;
+
+	PresentEffect = effect;
+	bPresent = effect != nullptr;
+
+	if (bWaitForRemoval)
+	{
+		if (bWasPresent && !bPresent)
+		{
+			OnChanged.Broadcast(previous);
+			OnTriggered();
+		}
+	}
+	else if (effect && (!bWasPresent || effect != previous))
+	{
+		OnChanged.Broadcast(effect);
+		OnTriggered();
+	}
+}
+
+void UASAsyncWaitEffect::HandleEffectListChanged(UASComponent* InComponent)
+{
+	Evaluate(InComponent);
+}
+
+void UASAsyncWaitEffect::HandleEffectAdded(UASComponent* InComponent, UEffect* InEffect)
+{
+	Evaluate(InComponent);
+}
+
+void UASAsyncWaitEffect::HandleEffectRemoved(UASComponent* InComponent, UEffect* InEffect)
+{
+	Evaluate(InComponent, InEffect);
+}
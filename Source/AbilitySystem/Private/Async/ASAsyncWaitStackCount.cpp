@@ -0,0 +1,92 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Async/ASAsyncWaitStackCount.h"
+
+#include "Components/ASComponent.h"
+#include "Objects/Effects/Effect.h"
+
+UASAsyncWaitStackCount* UASAsyncWaitStackCount::WaitStackCount(UASComponent* Component,
+                                                                TSubclassOf<UEffect> EffectClass,
+                                                                EASAsyncComparison Comparison, int32 Count,
+                                                                bool bTriggerOnce)
+{
+	UASAsyncWaitStackCount* action = NewObject<UASAsyncWaitStackCount>();
+	action->EffectClass = EffectClass;
+	action->Comparison = Comparison;
+	action->Count = Count;
+	action->Init(Component, bTriggerOnce);
+	return action;
+}
+
+void UASAsyncWaitStackCount::BindEvents(UASComponent* InComponent)
+{
+	FASComponentNativeEvents& events = InComponent->GetNativeEvents();
+	events.EffectAdded.AddUObject(this, &UASAsyncWaitStackCount::HandleEffectChanged);
+	events.EffectStackChanged.AddUObject(this, &UASAsyncWaitStackCount::HandleEffectChanged);
+	events.EffectRemoved.AddUObject(this, &UASAsyncWaitStackCount::HandleEffectRemoved);
+	events.EffectListUpdated.AddUObject(this, &UASAsyncWaitStackCount::HandleEffectListChanged);
+
+	Evaluate(InComponent);
+}
+
+void UASAsyncWaitStackCount::UnbindEvents(UASComponent* InComponent)
+{
+	if (InComponent && InComponent->HasNativeEvents())
+	{
+		FASComponentNativeEvents& events = InComponent->GetNativeEvents();
+		events.EffectAdded.RemoveAll(this);
+		events.EffectStackChanged.RemoveAll(this);
+		events.EffectRemoved.RemoveAll(this);
+		events.EffectListUpdated.RemoveAll(this);
+	}
+}
+
+void UASAsyncWaitStackCount::Evaluate(UASComponent* InComponent, UEffect* InRemoving)
+{
+	if (!IsWaiting())
+		return;
+
+	UEffect* effect = InComponent->Effect(EffectClass);
+	if (effect == InRemoving)
+	{
+		effect = nullptr;
+	}
+
+	const int32 stacks = effect ? effect->GetStackableNum() : 0;
+	const bool bSatisfied = Compare(stacks, Comparison, Count);
+	if (bSatisfied == bReached)
+		return;
+
+	bReached = bSatisfied;
+	if (bSatisfied)
+	{
+		OnCountReached.Broadcast(effect, stacks);
+		OnTriggered();
+	}
+	else
+	{
+		OnCountLeft.Broadcast(effect, stacks);
+	}
+}
+
+void UASAsyncWaitStackCount::HandleEffectListChanged(UASComponent* InComponent)
+{
+	Evaluate(InComponent);
+}
+
+void UASAsyncWaitStackCount::HandleEffectChanged(UASComponent* InComponent, UEffect* InEffect)
+{
+	if (InEffect && InEffect->IsA(EffectClass))
+	{
+		Evaluate(InComponent);
+	}
+}
+
+void UASAsyncWaitStackCount::HandleEffectRemoved(UASComponent* InComponent, UEffect* InEffect)
+{
+	if (InEffect && InEffect->IsA(EffectClass))
+	{
+		Evaluate(InComponent, InEffect);
+	}
+}
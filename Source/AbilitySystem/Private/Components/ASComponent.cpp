@@ -3,35 +3,343 @@
 
 #include "Components/ASComponent.h"
 
+#include "AbilitySystem.h"
+#include "Algo/Count.h"
 #include "Engine/ActorChannel.h"
+#include "GameFramework/GameStateBase.h"
+#include "Journal/ASJournalSubsystem.h"
 #include "Net/UnrealNetwork.h"
 #include "Net/Core/PushModel/PushModel.h"
 #include "Objects/Attribute.h"
+#include "Objects/Abilities/Ability.h"
 #include "Objects/Effects/Effect.h"
+#include "Serialization/ASSnapshot.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Stats/ASReplicationStats.h"
+#include "Subsystems/ASIndexSubsystem.h"
+#include "Subsystems/ASSpatialSubsystem.h"
+
+namespace
+{
+	/** Defers effect and attribute list mutations of the component until the notification ends */
+	struct FASNotificationScope
+	{
+		explicit FASNotificationScope(UASComponent* InComponent) : Component(InComponent)
+		{
+			Component->BeginNotification();
+		}
+
+		~FASNotificationScope()
+		{
+			Component->EndNotification();
+		}
+
+		UASComponent* Component;
+	};
+}
+
+namespace ASComponentSnapshot
+{
+	template <typename T>
+	void WriteEntities(FArchive& Ar, FASSnapshotClassTable& ClassTable, const TArray<T*>& Entities)
+	{
+		uint32 num = 0;
+		for (const T* entity : Entities)
+		{
+			num += IsValid(entity) ? 1 : 0;
+		}
+		Ar.SerializeIntPacked(num);
+
+		TArray<uint8> payload;
+		for (T* entity : Entities)
+		{
+			if (!IsValid(entity))
+				continue;
+
+			uint32 classIndex = ClassTable.FindOrAdd(entity->GetClass());
+			Ar.SerializeIntPacked(classIndex);
+
+			// Length-prefixed, so entries of missing classes can be skipped
+			payload.Reset();
+			FMemoryWriter payloadWriter(payload);
+			ASSnapshot::SetVersion(payloadWriter, EASSnapshotVersion::Latest);
+			entity->SerializeSnapshot(payloadWriter);
+			Ar << payload;
+		}
+	}
+
+	template <typename T>
+	bool ReadEntities(FArchive& Ar, EASSnapshotVersion Version, const FASSnapshotClassTable& ClassTable, UObject* Outer,
+	                  TArray<T*>& OutEntities)
+	{
+		uint32 num = 0;
+		Ar.SerializeIntPacked(num);
+		if (num > ASSnapshot::MaxEntries)
+		{
+			Ar.SetError();
+			return false;
+		}
+
+		TArray<uint8> payload;
+		for (uint32 i = 0; i < num && !Ar.IsError(); ++i)
+		{
+			uint32 classIndex = 0;
+			Ar.SerializeIntPacked(classIndex);
+
+			// Same layout as TArray<uint8> serialization, but the size is checked before allocating
+			int32 payloadSize = 0;
+			Ar << payloadSize;
+			if (Ar.IsError() || payloadSize < 0 || payloadSize > ASSnapshot::MaxPayloadBytes ||
+				payloadSize > Ar.TotalSize() - Ar.Tell())
+			{
+				Ar.SetError();
+				return false;
+			}
+			payload.SetNumUninitialized(payloadSize);
+			Ar.Serialize(payload.GetData(), payloadSize);
+
+			UClass* entityClass = ClassTable.Get(classIndex);
+			if (!entityClass || !entityClass->IsChildOf(T::StaticClass()) ||
+				entityClass->HasAnyClassFlags(CLASS_Abstract))
+			{
+				UE_LOG(LogAbilitySystem, Warning, TEXT("Snapshot entry of unknown class skipped (%s)"),
+				       *GetNameSafe(entityClass));
+				continue;
+			}
 
+			T* entity = NewObject<T>(Outer, entityClass);
+			FMemoryReader payloadReader(payload);
+			ASSnapshot::SetVersion(payloadReader, Version);
+			entity->SerializeSnapshot(payloadReader);
+			OutEntities.Add(entity);
+
+			// Payload must be consumed exactly, anything else means it does not match the class
+			if (payloadReader.IsError() || payloadReader.Tell() != payloadReader.TotalSize())
+			{
+				UE_LOG(LogAbilitySystem, Warning, TEXT("Snapshot entry of %s does not match its payload"),
+				       *entityClass->GetName());
+				Ar.SetError();
+				return false;
+			}
+		}
+		return !Ar.IsError();
+	}
+}
 
 // Sets default values for this component's properties
-UASComponent::UASComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+UASComponent::UASComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer),
+                                                                         AttributeListVersion(1),
+                                                                         DerivedAttributeBatchDepth(0),
+                                                                         MaxCascadeDepth(8),
+                                                                         NotificationDepth(0),
+                                                                         CascadeDepth(0),
+                                                                         bApplyingMutations(false),
+                                                                         AbilityListRevision(0),
+                                                                         ActivationFlushInterval(0.0f),
+                                                                         MaxActivationsPerBatch(16),
+                                                                         LastPredictionKey(0),
+                                                                         ActivationFlushAccumulator(0.0f),
+                                                                         EffectTimeMode(EASEffectTimeMode::WorldTimer),
+                                                                         FixedStepSize(1.0f / 30.0f),
+                                                                         bAutoAdvanceSimulation(true),
+                                                                         MaxStepsPerFrame(8),
+                                                                         SimulationStepCount(0),
+                                                                         StepAccumulator(0.0f),
+                                                                         EffectTimeScale(1.0f),
+                                                                         bEffectsPaused(false),
+                                                                         bRecordHistory(false),
+                                                                         HistoryCapacity(256),
+                                                                         MaxEffects(0),
+                                                                         MaxMemoryBytes(0),
+                                                                         BudgetPolicy(EASBudgetPolicy::EvictLowerPriority),
+                                                                         bSpatialIndexed(true),
+                                                                         InitialStateTimeout(1.0f),
+                                                                         bInitialStatePending(true),
+                                                                         bInitialStateFlushScheduled(false),
+                                                                         InitialStateStartTime(-1.0),
+                                                                         ConditionalEntityNum(0)
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	SetIsReplicatedByDefault(true);
 }
 
 
-void UASComponent::OnRep_Effects()
+void UASComponent::OnRep_Effects(const TArray<UEffect*>& OldEffects)
 {
-	OnEffectListUpdated.Broadcast(this);
+	for (UEffect* entity : OldEffects)
+	{
+		if (IsValid(entity) && !Effects.Contains(entity))
+		{
+			entity->OnRemovedOnClient();
+		}
+	}
+
+	ReindexEntityClasses();
+	if (DeferInitialRepNotify())
+		return;
+	BroadcastEvent(OnEffectListUpdated, &FASComponentNativeEvents::EffectListUpdated, this);
 }
 
 void UASComponent::OnRep_Attributes()
 {
-	OnAttributeListUpdated.Broadcast(this);
+	++AttributeListVersion;
+	ReindexEntityClasses();
+	if (DeferInitialRepNotify())
+		return;
+	BroadcastEvent(OnAttributeListUpdated, &FASComponentNativeEvents::AttributeListUpdated, this);
+}
+
+void UASComponent::OnRep_Abilities()
+{
+	if (DeferInitialRepNotify())
+		return;
+	BroadcastEvent(OnAbilityListUpdated, &FASComponentNativeEvents::AbilityListUpdated, this);
+}
+
+void UASComponent::OnRep_EffectClock()
+{
+	for (UEffect* entity : Effects)
+	{
+		if (IsValid(entity))
+		{
+			entity->OnEffectClockChanged();
+		}
+	}
+}
+
+bool UASComponent::DeferInitialRepNotify()
+{
+	if (!bInitialStatePending)
+		return false;
+
+	UWorld* world = GetWorld();
+	if (!world || GetNetMode() != NM_Client)
+	{
+		bInitialStatePending = false;
+		return false;
+	}
+
+	if (!bInitialStateFlushScheduled)
+	{
+		if (InitialStateStartTime < 0.0)
+		{
+			InitialStateStartTime = world->GetTimeSeconds();
+		}
+		bInitialStateFlushScheduled = true;
+		world->GetTimerManager().SetTimerForNextTick(
+			FTimerDelegate::CreateUObject(this, &UASComponent::FlushInitialState));
+	}
+	return true;
+}
+
+void UASComponent::FlushInitialState()
+{
+	bInitialStateFlushScheduled = false;
+	if (!bInitialStatePending)
+		return;
+
+	// Subobjects which are not mapped yet are null, wait for them unless a net condition may filter them
+	const int32 nullNum = Algo::Count(Effects, nullptr) + Algo::Count(Attributes, nullptr) +
+		Algo::Count(Abilities, nullptr);
+	const bool bComplete = nullNum <= ConditionalEntityNum;
+	if (!bComplete && GetWorld()->GetTimeSeconds() - InitialStateStartTime < InitialStateTimeout)
+	{
+		DeferInitialRepNotify();
+		return;
+	}
+
+	bInitialStatePending = false;
+	for (UAttribute* entity : Attributes)
+	{
+		if (IsValid(entity))
+		{
+			entity->NotifyInitialState();
+		}
+	}
+	BroadcastEvent(OnAttributeListUpdated, &FASComponentNativeEvents::AttributeListUpdated, this);
+	BroadcastEvent(OnEffectListUpdated, &FASComponentNativeEvents::EffectListUpdated, this);
+	BroadcastEvent(OnAbilityListUpdated, &FASComponentNativeEvents::AbilityListUpdated, this);
 }
 
 // Called when the game starts
 void UASComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Only clients receive an initial state
+	if (GetNetMode() != NM_Client)
+	{
+		bInitialStatePending = false;
+	}
+
+	if (UsesEffectScheduler())
+	{
+		UpdateEffectClock();
+	}
+
+	if (bRecordHistory && GetOwner()->HasAuthority())
+	{
+		History.Init(HistoryCapacity);
+		for (UAttribute* entity : Attributes)
+		{
+			if (IsValid(entity))
+			{
+				RecordHistory(entity->GetClass(), EASHistoryRecordType::AttributeValue, entity->GetCurrentValue());
+			}
+		}
+		for (UEffect* entity : Effects)
+		{
+			if (IsValid(entity))
+			{
+				RecordHistory(entity->GetClass(), EASHistoryRecordType::EffectAdded);
+			}
+		}
+	}
+
+	if (UASIndexSubsystem* index = GetWorld()->GetSubsystem<UASIndexSubsystem>())
+	{
+		index->RegisterComponent(this);
+	}
+	ReindexEntityClasses();
+
+	if (bSpatialIndexed)
+	{
+		if (UASSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UASSpatialSubsystem>())
+		{
+			spatial->Register(this);
+		}
+	}
+}
+
+void UASComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	EffectScheduler.Reset();
+
+	const bool bClient = !GetOwner()->HasAuthority();
+	for (UEffect* entity : Effects)
+	{
+		if (IsValid(entity))
+		{
+			UnindexEffect(entity);
+			if (bClient)
+			{
+				entity->OnRemovedOnClient();
+			}
+		}
+	}
+	ClearIndexedEntityClasses();
+	if (UASIndexSubsystem* index = GetWorld()->GetSubsystem<UASIndexSubsystem>())
+	{
+		index->UnregisterComponent(this);
+	}
+
+	if (UASSpatialSubsystem* spatial = GetWorld()->GetSubsystem<UASSpatialSubsystem>())
+	{
+		spatial->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 
@@ -40,7 +348,367 @@ void UASComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorCom
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	// ...
+	const float effectDeltaTime = bEffectsPaused ? 0.0f : DeltaTime * EffectTimeScale;
+	if (EffectTimeMode == EASEffectTimeMode::FixedStep && bAutoAdvanceSimulation && GetOwner()->HasAuthority())
+	{
+		StepAccumulator += effectDeltaTime;
+		int32 steps = 0;
+		while (StepAccumulator >= FixedStepSize && steps < MaxStepsPerFrame)
+		{
+			StepAccumulator -= FixedStepSize;
+			SimulationStep();
+			++steps;
+		}
+		// Do not spiral after a hitch, drop what could not be simulated this frame
+		if (StepAccumulator > FixedStepSize)
+		{
+			StepAccumulator = FixedStepSize;
+			UpdateEffectClock();
+		}
+	}
+	else if (EffectTimeMode == EASEffectTimeMode::ComponentClock && effectDeltaTime > 0.0f &&
+		GetOwner()->HasAuthority())
+	{
+		EffectScheduler.AdvanceTo(EffectScheduler.GetTime() + effectDeltaTime);
+	}
+
+	if (PendingActivations.Num() > 0)
+	{
+		ActivationFlushAccumulator += DeltaTime;
+		if (ActivationFlushAccumulator >= ActivationFlushInterval)
+		{
+			FlushActivationRequests();
+		}
+	}
+}
+
+void UASComponent::SimulationStep()
+{
+	++SimulationStepCount;
+	// Computed from the step count to not accumulate float error
+	EffectScheduler.AdvanceTo(static_cast<double>(SimulationStepCount) * FixedStepSize);
+}
+
+void UASComponent::SetEffectTimeScale(float InTimeScale)
+{
+	const float timeScale = FMath::Max(InTimeScale, 0.0f);
+	if (timeScale == EffectTimeScale)
+		return;
+
+	EffectTimeScale = timeScale;
+	UpdateEffectClock();
+}
+
+void UASComponent::SetEffectsPaused(bool bInPaused)
+{
+	if (bInPaused == static_cast<bool>(bEffectsPaused))
+		return;
+
+	bEffectsPaused = bInPaused;
+	UpdateEffectClock();
+}
+
+double UASComponent::GetEffectTime() const
+{
+	if (!UsesEffectScheduler())
+		return GetServerWorldTime();
+
+	return GetOwner()->HasAuthority() ? EffectScheduler.GetTime() : EffectClock.GetTime(GetServerWorldTime());
+}
+
+double UASComponent::GetServerWorldTime() const
+{
+	const UWorld* world = GetWorld();
+	if (!world)
+		return 0.0;
+
+	const AGameStateBase* gameState = world->GetGameState();
+	return gameState ? gameState->GetServerWorldTimeSeconds() : world->GetTimeSeconds();
+}
+
+void UASComponent::UpdateEffectClock()
+{
+	if (!GetOwner()->HasAuthority())
+		return;
+
+	EffectClock.ServerTime = GetServerWorldTime();
+	EffectClock.Time = EffectScheduler.GetTime();
+	// Manually advanced simulations only move on AdvanceSimulation, which republishes the clock
+	const bool bManualSimulation = EffectTimeMode == EASEffectTimeMode::FixedStep && !bAutoAdvanceSimulation;
+	EffectClock.Rate = bEffectsPaused || bManualSimulation ? 0.0f : EffectTimeScale;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, EffectClock, this);
+	AS_RECORD_PROPERTY_UPDATE(UASComponent, EffectClock, this);
+}
+
+void UASComponent::BindAttributeEvents(UAttribute* InAttribute)
+{
+	if (bRecordHistory || (PrepareDerivedAttributes() && DerivedAttributeGraph.IsSource(InAttribute->GetClass())))
+	{
+		FASAttributeValueNativeEvent& valueChanged = InAttribute->GetNativeEvents().ValueChanged;
+		if (!valueChanged.IsBoundToObject(this))
+		{
+			valueChanged.AddUObject(this, &UASComponent::HandleAttributeValueChanged);
+		}
+	}
+}
+
+void UASComponent::HandleAttributeValueChanged(UAttribute* InAttribute, float InValue)
+{
+	if (IsValid(InAttribute))
+	{
+		RecordHistory(InAttribute->GetClass(), EASHistoryRecordType::AttributeValue, InValue);
+
+		if (PrepareDerivedAttributes())
+		{
+			DerivedAttributeGraph.MarkChanged(InAttribute);
+			UpdateDerivedAttributes();
+		}
+	}
+}
+
+bool UASComponent::PrepareDerivedAttributes()
+{
+	if (DerivedAttributes.Num() == 0)
+		return false;
+
+	if (!DerivedAttributeGraph.IsBuilt())
+	{
+		DerivedAttributeGraph.Build(DerivedAttributes, this);
+	}
+	if (DerivedAttributeGraph.GetResolvedVersion() != AttributeListVersion)
+	{
+		DerivedAttributeGraph.Resolve(this);
+	}
+	return !DerivedAttributeGraph.IsEmpty();
+}
+
+void UASComponent::BeginDerivedAttributeBatch()
+{
+	++DerivedAttributeBatchDepth;
+}
+
+void UASComponent::EndDerivedAttributeBatch()
+{
+	if (ensure(DerivedAttributeBatchDepth > 0))
+	{
+		--DerivedAttributeBatchDepth;
+	}
+	UpdateDerivedAttributes();
+}
+
+void UASComponent::UpdateDerivedAttributes()
+{
+	if (DerivedAttributeBatchDepth > 0 || !GetOwner()->HasAuthority() || !PrepareDerivedAttributes())
+		return;
+
+	if (!DerivedAttributeGraph.HasDirtyNodes())
+		return;
+
+	// Targets written during evaluation only mark later nodes of the same pass
+	++DerivedAttributeBatchDepth;
+	DerivedAttributeGraph.Evaluate();
+	--DerivedAttributeBatchDepth;
+}
+
+void UASComponent::BeginNotification()
+{
+	++NotificationDepth;
+}
+
+void UASComponent::EndNotification()
+{
+	if (ensure(NotificationDepth > 0))
+	{
+		--NotificationDepth;
+	}
+	if (NotificationDepth == 0 && PendingMutations.Num() > 0)
+	{
+		ApplyPendingMutations();
+	}
+}
+
+bool UASComponent::DeferMutation(EASPendingMutationType InType, UObject* InEntity, UClass* InClass,
+                                 const FASEffectContext* InContext)
+{
+	if (NotificationDepth == 0)
+		return false;
+
+	const UClass* mutatedClass = InEntity ? InEntity->GetClass() : InClass;
+	const int32 depth = CascadeDepth + 1;
+	if (depth > MaxCascadeDepth)
+	{
+		UE_LOG(LogAbilitySystem, Warning, TEXT("%s: mutation of %s dropped, cascade depth %d exceeds MaxCascadeDepth"),
+		       *GetPathName(), *GetNameSafe(mutatedClass), depth);
+		return true;
+	}
+
+	UE_LOG(LogAbilitySystem, Verbose, TEXT("%s: mutation of %s deferred, cascade depth %d"), *GetPathName(),
+	       *GetNameSafe(mutatedClass), depth);
+
+	FASPendingMutation& mutation = PendingMutations.AddDefaulted_GetRef();
+	mutation.Entity = InEntity;
+	mutation.Class = InClass;
+	mutation.Depth = depth;
+	mutation.Type = InType;
+	if (InContext)
+	{
+		mutation.Instigator = InContext->Instigator;
+		mutation.Source = InContext->Source;
+	}
+	return true;
+}
+
+void UASComponent::ApplyPendingMutations()
+{
+	if (bApplyingMutations)
+		return;
+
+	bApplyingMutations = true;
+
+	// Applied mutations may queue further ones, they are appended and applied in the same pass
+	for (int32 i = 0; i < PendingMutations.Num(); ++i)
+	{
+		const FASPendingMutation mutation = PendingMutations[i];
+		CascadeDepth = mutation.Depth;
+
+		switch (mutation.Type)
+		{
+		case EASPendingMutationType::AddEffect:
+			AddEffect(mutation.Class.Get(), FASEffectContext(mutation.Instigator.Get(), mutation.Source.Get()));
+			break;
+		case EASPendingMutationType::RemoveEffect:
+			RemoveEffectByEntity(Cast<UEffect>(mutation.Entity.Get()));
+			break;
+		case EASPendingMutationType::RemoveEffectByClass:
+			RemoveEffectByClass(mutation.Class.Get());
+			break;
+		case EASPendingMutationType::AddAttribute:
+			AddAttribute(mutation.Class.Get());
+			break;
+		case EASPendingMutationType::RemoveAttribute:
+			RemoveAttributeByEntity(Cast<UAttribute>(mutation.Entity.Get()));
+			break;
+		case EASPendingMutationType::RemoveAttributeByClass:
+			RemoveAttributeByClass(mutation.Class.Get());
+			break;
+		}
+	}
+
+	PendingMutations.Reset();
+	CascadeDepth = 0;
+	bApplyingMutations = false;
+}
+
+void UASComponent::RecordHistory(const UClass* InClass, EASHistoryRecordType InType, float InValue)
+{
+	if (!History.IsEnabled())
+		return;
+
+	FASHistoryRecord record;
+	record.Time = GetWorld()->GetTimeSeconds();
+	record.Class = InClass;
+	record.Value = InValue;
+	record.Type = InType;
+	History.Add(record);
+}
+
+bool UASComponent::GetAttributeValueAtTime(TSubclassOf<UAttribute> AttributeClass, double ServerTime,
+                                           float& OutValue) const
+{
+	OutValue = 0.0f;
+	if (!AttributeClass || !History.IsEnabled())
+		return false;
+
+	// Changes around that time have been overwritten, the current value would be a guess
+	if (!History.Covers(ServerTime))
+		return false;
+
+	bool bChangedLater = false;
+	const int32 n = History.Num();
+	for (int32 i = 0; i < n; ++i)
+	{
+		const FASHistoryRecord& record = History.GetFromNewest(i);
+		if (record.Type != EASHistoryRecordType::AttributeValue || record.Class != AttributeClass.Get())
+			continue;
+
+		// Newest change at or before the requested time
+		if (record.Time <= ServerTime)
+		{
+			OutValue = record.Value;
+			return true;
+		}
+		bChangedLater = true;
+	}
+
+	// Attribute did not exist yet, or its value at that time is no longer recorded
+	if (bChangedLater)
+		return false;
+
+	// No change within the recorded history, the value is still the same
+	for (const UAttribute* entity : Attributes)
+	{
+		if (IsValid(entity) && entity->GetClass() == AttributeClass.Get())
+		{
+			OutValue = entity->GetCurrentValue();
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UASComponent::HadEffectAtTime(TSubclassOf<UEffect> EffectClass, double ServerTime) const
+{
+	if (!EffectClass || !History.IsEnabled())
+		return false;
+
+	// Overwritten records may have added or removed the effect around that time
+	if (!History.Covers(ServerTime))
+		return false;
+
+	const FASHistoryRecord* earliestLater = nullptr;
+	const int32 n = History.Num();
+	for (int32 i = 0; i < n; ++i)
+	{
+		const FASHistoryRecord& record = History.GetFromNewest(i);
+		if (record.Type == EASHistoryRecordType::AttributeValue || record.Class != EffectClass.Get())
+			continue;
+
+		// Newest change at or before the requested time defines the state
+		if (record.Time <= ServerTime)
+			return record.Type == EASHistoryRecordType::EffectAdded;
+
+		earliestLater = &record;
+	}
+
+	// Only later changes: the state before the first of them
+	if (earliestLater)
+		return earliestLater->Type == EASHistoryRecordType::EffectRemoved;
+
+	// No change within the recorded history, the state is still the same
+	for (const UEffect* entity : Effects)
+	{
+		if (IsValid(entity) && entity->GetClass() == EffectClass.Get())
+			return true;
+	}
+	return false;
+}
+
+double UASComponent::GetHistoryStartTime() const
+{
+	return History.Num() > 0 ? History.GetFromNewest(History.Num() - 1).Time : GetWorld()->GetTimeSeconds();
+}
+
+void UASComponent::AdvanceSimulation(int32 NumSteps)
+{
+	if (EffectTimeMode != EASEffectTimeMode::FixedStep)
+		return;
+
+	for (int32 i = 0; i < NumSteps; ++i)
+	{
+		SimulationStep();
+	}
+
+	UpdateEffectClock();
 }
 
 void UASComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -50,6 +718,130 @@ void UASComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLife
 	Params.bIsPushBased = true;
 	DOREPLIFETIME_WITH_PARAMS_FAST(UASComponent, Effects, Params);
 	DOREPLIFETIME_WITH_PARAMS_FAST(UASComponent, Attributes, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UASComponent, Abilities, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UASComponent, AbilityListRevision, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UASComponent, EffectClock, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UASComponent, ConditionalEntityNum, Params);
+}
+
+void UASComponent::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(
+		Effects.GetAllocatedSize() + Attributes.GetAllocatedSize() + Abilities.GetAllocatedSize() +
+		History.GetAllocatedSize() + EffectScheduler.GetAllocatedSize() +
+		DerivedAttributeGraph.GetAllocatedSize() + PendingActivations.GetAllocatedSize() +
+		EffectsByInstigator.GetAllocatedSize() + EffectInstigators.GetAllocatedSize() +
+		IndexedClasses.GetAllocatedSize());
+
+	if (NativeEvents.IsValid())
+	{
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(sizeof(FASComponentNativeEvents) +
+			NativeEvents->GetAllocatedSize());
+	}
+
+	if (CumulativeResourceSize.GetResourceSizeMode() != EResourceSizeMode::EstimatedTotal)
+		return;
+
+	// Entities are owned by the actor, but exist only for this component
+	for (UEffect* entity : Effects)
+	{
+		if (IsValid(entity))
+		{
+			entity->GetResourceSizeEx(CumulativeResourceSize);
+		}
+	}
+	for (UAttribute* entity : Attributes)
+	{
+		if (IsValid(entity))
+		{
+			entity->GetResourceSizeEx(CumulativeResourceSize);
+		}
+	}
+	for (UAbility* entity : Abilities)
+	{
+		if (IsValid(entity))
+		{
+			entity->GetResourceSizeEx(CumulativeResourceSize);
+		}
+	}
+}
+
+bool UASComponent::EnforceEffectBudget(UEffect* InEffect)
+{
+	if (MaxEffects <= 0 && MaxMemoryBytes <= 0)
+		return true;
+
+	// Measured once, evicted effects are subtracted instead of walking the component again
+	int64 memoryBytes = 0;
+	if (MaxMemoryBytes > 0)
+	{
+		memoryBytes = GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal) +
+			InEffect->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	}
+	auto isOverBudget = [this, &memoryBytes]()
+	{
+		return (MaxEffects > 0 && Effects.Num() >= MaxEffects) || (MaxMemoryBytes > 0 && memoryBytes > MaxMemoryBytes);
+	};
+
+	while (isOverBudget())
+	{
+		UEffect* victim = nullptr;
+		if (BudgetPolicy == EASBudgetPolicy::EvictLowerPriority)
+		{
+			// Lowest priority, the oldest one on ties
+			for (UEffect* entity : Effects)
+			{
+				if (IsValid(entity) && entity->GetPriority() < InEffect->GetPriority() &&
+					(!victim || entity->GetPriority() < victim->GetPriority()))
+				{
+					victim = entity;
+				}
+			}
+		}
+
+		if (!victim)
+		{
+			UE_LOG(LogAbilitySystem, Verbose, TEXT("%s: effect %s rejected, budget exceeded"), *GetPathName(),
+			       *GetNameSafe(InEffect->GetClass()));
+			return false;
+		}
+		if (MaxMemoryBytes > 0)
+		{
+			memoryBytes -= victim->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+		RemoveEffectByEntity(victim);
+	}
+	return true;
+}
+
+void UASComponent::AddReplicatedEntity(UBasicAsEntity* InEntity)
+{
+	if (GetOwner()->HasAuthority())
+	{
+		AddReplicatedSubObject(InEntity, InEntity->GetNetCondition());
+		if (InEntity->GetNetCondition() != COND_None)
+		{
+			++ConditionalEntityNum;
+			MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, ConditionalEntityNum, this);
+			AS_RECORD_PROPERTY_UPDATE(UASComponent, ConditionalEntityNum, this);
+		}
+	}
+}
+
+void UASComponent::RemoveReplicatedEntity(UBasicAsEntity* InEntity)
+{
+	if (GetOwner()->HasAuthority())
+	{
+		RemoveReplicatedSubObject(InEntity);
+		if (InEntity->GetNetCondition() != COND_None && ConditionalEntityNum > 0)
+		{
+			--ConditionalEntityNum;
+			MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, ConditionalEntityNum, this);
+			AS_RECORD_PROPERTY_UPDATE(UASComponent, ConditionalEntityNum, this);
+		}
+	}
 }
 
 bool UASComponent::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags)
@@ -60,20 +852,191 @@ bool UASComponent::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch,
 	{
 		if (IsValid(entity))
 		{
-			sup |= Channel->ReplicateSubobject(entity, *Bunch, *RepFlags);
-			sup |= entity->ReplicateSubobjects(Channel, Bunch, RepFlags);
+			sup |= entity->ReplicateAsSubobject(Channel, Bunch, RepFlags);
+		}
+	}
+
+	for (UAttribute* entity : Attributes)
+	{
+		if (IsValid(entity))
+		{
+			sup |= entity->ReplicateAsSubobject(Channel, Bunch, RepFlags);
+		}
+	}
+
+	for (UAbility* entity : Abilities)
+	{
+		if (IsValid(entity))
+		{
+			sup |= entity->ReplicateAsSubobject(Channel, Bunch, RepFlags);
+		}
+	}
+	return sup;
+}
+
+void UASComponent::SaveSnapshot(TArray<uint8>& OutData) const
+{
+	FASSnapshotClassTable classTable;
+	TArray<uint8> body;
+	{
+		FMemoryWriter bodyWriter(body);
+		ASComponentSnapshot::WriteEntities(bodyWriter, classTable, Attributes);
+		ASComponentSnapshot::WriteEntities(bodyWriter, classTable, Effects);
+		ASComponentSnapshot::WriteEntities(bodyWriter, classTable, Abilities);
+	}
+
+	OutData.Reset();
+	FMemoryWriter writer(OutData);
+	ASSnapshot::WriteHeader(writer);
+	classTable.Serialize(writer);
+	writer.Serialize(body.GetData(), body.Num());
+}
+
+bool UASComponent::RestoreSnapshot(const TArray<uint8>& InData)
+{
+	if (!GetOwner()->HasAuthority())
+		return false;
+
+	FMemoryReader reader(InData);
+	EASSnapshotVersion version;
+	if (!ASSnapshot::ReadHeader(reader, version))
+	{
+		UE_LOG(LogAbilitySystem, Warning, TEXT("%s: snapshot header is invalid or not supported"),
+		       *GetPathName());
+		return false;
+	}
+
+	FASSnapshotClassTable classTable;
+	classTable.Serialize(reader);
+
+	// Read everything first, current state is only touched if the snapshot is valid
+	TArray<UAttribute*> newAttributes;
+	TArray<UEffect*> newEffects;
+	TArray<UAbility*> newAbilities;
+	const bool bHasAbilities = version >= EASSnapshotVersion::Abilities;
+	if (reader.IsError() ||
+		!ASComponentSnapshot::ReadEntities(reader, version, classTable, GetOwner(), newAttributes) ||
+		!ASComponentSnapshot::ReadEntities(reader, version, classTable, GetOwner(), newEffects) ||
+		(bHasAbilities && !ASComponentSnapshot::ReadEntities(reader, version, classTable, GetOwner(), newAbilities)))
+	{
+		UE_LOG(LogAbilitySystem, Warning, TEXT("%s: snapshot data is corrupted"), *GetPathName());
+		for (UAttribute* entity : newAttributes)
+		{
+			entity->ConditionalBeginDestroy();
+		}
+		for (UEffect* entity : newEffects)
+		{
+			entity->ConditionalBeginDestroy();
+		}
+		for (UAbility* entity : newAbilities)
+		{
+			entity->ConditionalBeginDestroy();
 		}
+		return false;
 	}
 
+	// Drop current state silently
+	for (UEffect* entity : Effects)
+	{
+		if (IsValid(entity))
+		{
+			entity->OnWorkEnded();
+			RecordHistory(entity->GetClass(), EASHistoryRecordType::EffectRemoved);
+			AS_JOURNAL_RECORD(GetOwner(), EffectRemoved, entity->GetClass(), 0.0f);
+			UnindexEffect(entity);
+			RemoveReplicatedEntity(entity);
+			entity->ConditionalBeginDestroy();
+		}
+	}
 	for (UAttribute* entity : Attributes)
 	{
 		if (IsValid(entity))
 		{
-			sup |= Channel->ReplicateSubobject(entity, *Bunch, *RepFlags);
-			sup |= entity->ReplicateSubobjects(Channel, Bunch, RepFlags);
+			entity->OnWorkEnded();
+			RemoveReplicatedEntity(entity);
+			entity->ConditionalBeginDestroy();
+		}
+	}
+
+	// Older snapshots have no abilities, current ones are kept
+	if (bHasAbilities)
+	{
+		for (UAbility* entity : Abilities)
+		{
+			if (IsValid(entity))
+			{
+				RemoveReplicatedEntity(entity);
+				entity->ConditionalBeginDestroy();
+			}
+		}
+		Abilities = MoveTemp(newAbilities);
+		for (UAbility* entity : Abilities)
+		{
+			AddReplicatedEntity(entity);
+		}
+		MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Abilities, this);
+		AS_RECORD_PROPERTY_UPDATE(UASComponent, Abilities, this);
+		++AbilityListRevision;
+		MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, AbilityListRevision, this);
+		AS_RECORD_PROPERTY_UPDATE(UASComponent, AbilityListRevision, this);
+	}
+
+	Attributes = MoveTemp(newAttributes);
+	Effects = MoveTemp(newEffects);
+	++AttributeListVersion;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Attributes, this);
+	AS_RECORD_PROPERTY_UPDATE(UASComponent, Attributes, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Effects, this);
+	AS_RECORD_PROPERTY_UPDATE(UASComponent, Effects, this);
+	ReindexEntityClasses();
+
+	FASNotificationScope scope(this);
+	for (UAttribute* entity : Attributes)
+	{
+		AddReplicatedEntity(entity);
+		BindAttributeEvents(entity);
+		RecordHistory(entity->GetClass(), EASHistoryRecordType::AttributeValue, entity->GetCurrentValue());
+	}
+	for (UEffect* entity : Effects)
+	{
+		AddReplicatedEntity(entity);
+		RecordHistory(entity->GetClass(), EASHistoryRecordType::EffectAdded);
+		entity->ResumeWork();
+	}
+	UpdateDerivedAttributes();
+
+	// Single batched notification
+	{
+		for (UAttribute* entity : Attributes)
+		{
+			if (entity->HasEntityHook(EASEntityHooks::AttributeListUpdated))
+			{
+				entity->OnAttributeListUpdated();
+			}
+			if (entity->HasEntityHook(EASEntityHooks::EffectListUpdated))
+			{
+				entity->OnEffectListUpdated();
+			}
+		}
+		for (UEffect* entity : Effects)
+		{
+			if (entity->HasEntityHook(EASEntityHooks::AttributeListUpdated))
+			{
+				entity->OnAttributeListUpdated();
+			}
+			if (entity->HasEntityHook(EASEntityHooks::EffectListUpdated))
+			{
+				entity->OnEffectListUpdated();
+			}
+		}
+		BroadcastEvent(OnAttributeListUpdated, &FASComponentNativeEvents::AttributeListUpdated, this);
+		BroadcastEvent(OnEffectListUpdated, &FASComponentNativeEvents::EffectListUpdated, this);
+		if (bHasAbilities)
+		{
+			BroadcastEvent(OnAbilityListUpdated, &FASComponentNativeEvents::AbilityListUpdated, this);
 		}
 	}
-	return sup;
+	return true;
 }
 
 void UASComponent::EffectHasEnded(UEffect* InEffect)
@@ -87,63 +1050,94 @@ void UASComponent::EffectHasEnded(UEffect* InEffect)
 	RemoveEffectByEntity(InEffect);
 }
 
+void UASComponent::NotifyEffectStackChanged(UEffect* InEffect)
+{
+	AS_JOURNAL_RECORD(GetOwner(), EffectStackChanged, InEffect->GetClass(), InEffect->GetStackableNum());
+	BroadcastEvent(OnEffectStackChanged, &FASComponentNativeEvents::EffectStackChanged, this, InEffect);
+}
+
 void UASComponent::RemoveEffectByEntity(const UEffect* InEffect)
 {
 	if (!IsValid(InEffect))
 		return;
 
+	if (DeferMutation(EASPendingMutationType::RemoveEffect, const_cast<UEffect*>(InEffect), nullptr))
+		return;
+
 
 	// Iterate through the Effects array
-	const int32 n = Effects.Num();
-	for (int32 i = 0; i < n; ++i)
+	for (int32 i = 0; i < Effects.Num(); ++i)
 	{
 		UEffect*& entity = Effects[i];
 
 		// Check if the Effect's pointer matches the provided InEffect
 		if (IsValid(entity) && InEffect == entity)
 		{
+			FASNotificationScope scope(this);
+
+			// Tick queued in the same frame still counts
+			entity->FlushQueuedPeriodTick();
+
 			// Notify effect
 			entity->OnWorkEnded();
 
 			{
 				// Notify all effects except target
-				for (int32 j = 0; j < n; ++j)
+				for (int32 j = 0; j < Effects.Num(); ++j)
 				{
 					if (j != i)
 					{
-						Effects[j]->OnEffectRemoving(entity);
+						if (Effects[j]->HasEntityHook(EASEntityHooks::EffectRemoving))
+						{
+							Effects[j]->OnEffectRemoving(entity);
+						}
 					}
 				}
 				// Notify all attributes
 				for (int32 k = 0; k < Attributes.Num(); ++k)
 				{
-					Attributes[k]->OnEffectRemoving(entity);
+					if (Attributes[k]->HasEntityHook(EASEntityHooks::EffectRemoving))
+					{
+						Attributes[k]->OnEffectRemoving(entity);
+					}
 				}
 
-				OnEffectRemoved.Broadcast(this, entity);
+				BroadcastEvent(OnEffectRemoved, &FASComponentNativeEvents::EffectRemoved, this, entity);
 			}
 
 
+			RecordHistory(entity->GetClass(), EASHistoryRecordType::EffectRemoved);
+			AS_JOURNAL_RECORD(GetOwner(), EffectRemoved, entity->GetClass(), 0.0f);
+			UnindexEffect(entity);
+
 			// Memory cleanup
+			RemoveReplicatedEntity(entity);
 			entity->ConditionalBeginDestroy();
 			entity = nullptr;
 
 			// Remove it from the array
 			Effects.RemoveAt(i);
 			MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Effects, this);
+			AS_RECORD_PROPERTY_UPDATE(UASComponent, Effects, this);
 
 			{
 				for (int32 j = 0; j < Effects.Num(); ++j)
 				{
-					Effects[j]->OnEffectListUpdated();
+					if (Effects[j]->HasEntityHook(EASEntityHooks::EffectListUpdated))
+					{
+						Effects[j]->OnEffectListUpdated();
+					}
 				}
 
 				for (int32 j = 0; j < Attributes.Num(); ++j)
 				{
-					Attributes[j]->OnEffectListUpdated();
+					if (Attributes[j]->HasEntityHook(EASEntityHooks::EffectListUpdated))
+					{
+						Attributes[j]->OnEffectListUpdated();
+					}
 				}
 
-				OnEffectListUpdated.Broadcast(this);
+				BroadcastEvent(OnEffectListUpdated, &FASComponentNativeEvents::EffectListUpdated, this);
 			}
 
 			return;
@@ -156,54 +1150,79 @@ void UASComponent::RemoveEffectByClass(TSubclassOf<UEffect> EffectClass)
 	if (!EffectClass)
 		return;
 
+	if (DeferMutation(EASPendingMutationType::RemoveEffectByClass, nullptr, EffectClass))
+		return;
+
 	// Iterate through the Effects array
-	const int32 n = Effects.Num();
-	for (int32 i = 0; i < n; ++i)
+	for (int32 i = 0; i < Effects.Num(); ++i)
 	{
 		UEffect*& entity = Effects[i];
 
 		// Check if the Effect's class matches the provided EffectClass
 		if (IsValid(entity) && entity->IsA(EffectClass))
 		{
+			FASNotificationScope scope(this);
+
+			// Tick queued in the same frame still counts
+			entity->FlushQueuedPeriodTick();
+
 			// Notify effect
 			entity->OnWorkEnded();
 
 			{
 				// Notify all effects except target
-				for (int32 j = 0; j < n; ++j)
+				for (int32 j = 0; j < Effects.Num(); ++j)
 				{
 					if (j != i)
 					{
-						Effects[j]->OnEffectRemoving(entity);
+						if (Effects[j]->HasEntityHook(EASEntityHooks::EffectRemoving))
+						{
+							Effects[j]->OnEffectRemoving(entity);
+						}
 					}
 				}
 				// Notify all attributes
 				for (int32 k = 0; k < Attributes.Num(); ++k)
 				{
-					Attributes[k]->OnEffectRemoving(entity);
+					if (Attributes[k]->HasEntityHook(EASEntityHooks::EffectRemoving))
+					{
+						Attributes[k]->OnEffectRemoving(entity);
+					}
 				}
-				OnEffectRemoved.Broadcast(this, entity);
+				BroadcastEvent(OnEffectRemoved, &FASComponentNativeEvents::EffectRemoved, this, entity);
 			}
 
+			RecordHistory(entity->GetClass(), EASHistoryRecordType::EffectRemoved);
+			AS_JOURNAL_RECORD(GetOwner(), EffectRemoved, entity->GetClass(), 0.0f);
+			UnindexEffect(entity);
+
 			// Memory cleanup
+			RemoveReplicatedEntity(entity);
 			entity->ConditionalBeginDestroy();
 			entity = nullptr;
 
 			// Remove it from the array
 			Effects.RemoveAt(i);
 			MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Effects, this);
+			AS_RECORD_PROPERTY_UPDATE(UASComponent, Effects, this);
 
 			{
 				for (int32 j = 0; j < Effects.Num(); ++j)
 				{
-					Effects[j]->OnEffectListUpdated();
+					if (Effects[j]->HasEntityHook(EASEntityHooks::EffectListUpdated))
+					{
+						Effects[j]->OnEffectListUpdated();
+					}
 				}
 
 				for (int32 j = 0; j < Attributes.Num(); ++j)
 				{
-					Attributes[j]->OnEffectListUpdated();
+					if (Attributes[j]->HasEntityHook(EASEntityHooks::EffectListUpdated))
+					{
+						Attributes[j]->OnEffectListUpdated();
+					}
 				}
-				OnEffectListUpdated.Broadcast(this);
+				BroadcastEvent(OnEffectListUpdated, &FASComponentNativeEvents::EffectListUpdated, this);
 			}
 
 			return;
@@ -211,12 +1230,16 @@ void UASComponent::RemoveEffectByClass(TSubclassOf<UEffect> EffectClass)
 	}
 }
 
-UEffect* UASComponent::AddEffect(TSubclassOf<UEffect> EffectClass)
+UEffect* UASComponent::AddEffect(TSubclassOf<UEffect> EffectClass, const FASEffectContext& Context)
 {
 	if (!EffectClass)
 		return nullptr;
 
+	if (DeferMutation(EASPendingMutationType::AddEffect, nullptr, EffectClass, &Context))
+		return nullptr;
+
 	UEffect* temp = NewObject<UEffect>(GetOwner(), EffectClass);
+	temp->SetContext(Context);
 
 	const int32 n = Effects.Num();
 	for (int32 i = 0; i < n; ++i)
@@ -228,9 +1251,10 @@ UEffect* UASComponent::AddEffect(TSubclassOf<UEffect> EffectClass)
 			// Can we stack?
 			if (temp->IsStackable() && entity->IsStackable())
 			{
+				FASNotificationScope scope(this);
 				if (entity->Stack(temp))
 				{
-					OnEffectStacked.Broadcast(this, entity);
+					BroadcastEvent(OnEffectStacked, &FASComponentNativeEvents::EffectStacked, this, entity);
 				}
 			}
 
@@ -240,24 +1264,52 @@ UEffect* UASComponent::AddEffect(TSubclassOf<UEffect> EffectClass)
 			return nullptr;
 		}
 	}
+
+	if (!EnforceEffectBudget(temp))
+	{
+		temp->ConditionalBeginDestroy();
+		return nullptr;
+	}
+
+	// Evicted effects may have changed the list
+	const int32 previousNum = Effects.Num();
 	Effects.Add(temp);
+	AddReplicatedEntity(temp);
+	IndexEffect(temp);
+	RecordHistory(temp->GetClass(), EASHistoryRecordType::EffectAdded);
+	AS_JOURNAL_RECORD(GetOwner(), EffectAdded, temp->GetClass(), temp->GetStackableNum());
 	MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Effects, this);
+	AS_RECORD_PROPERTY_UPDATE(UASComponent, Effects, this);
+
+	FASNotificationScope scope(this);
 	temp->StartWork();
 	{
-		// Notify all Effects except target (n is previous)
-		for (int32 i = 0; i < n; ++i)
+		// Notify all Effects except target
+		for (int32 i = 0; i < previousNum; ++i)
 		{
-			Effects[i]->OnEffectAdded(temp);
-			Effects[i]->OnEffectListUpdated();
+			if (Effects[i]->HasEntityHook(EASEntityHooks::EffectAdded))
+			{
+				Effects[i]->OnEffectAdded(temp);
+			}
+			if (Effects[i]->HasEntityHook(EASEntityHooks::EffectListUpdated))
+			{
+				Effects[i]->OnEffectListUpdated();
+			}
 		}
 		// Notify all attributes
 		for (int32 k = 0; k < Attributes.Num(); ++k)
 		{
-			Attributes[k]->OnEffectAdded(temp);
-			Attributes[k]->OnEffectListUpdated();
+			if (Attributes[k]->HasEntityHook(EASEntityHooks::EffectAdded))
+			{
+				Attributes[k]->OnEffectAdded(temp);
+			}
+			if (Attributes[k]->HasEntityHook(EASEntityHooks::EffectListUpdated))
+			{
+				Attributes[k]->OnEffectListUpdated();
+			}
 		}
-		OnEffectAdded.Broadcast(this, temp);
-		OnEffectListUpdated.Broadcast(this);
+		BroadcastEvent(OnEffectAdded, &FASComponentNativeEvents::EffectAdded, this, temp);
+		BroadcastEvent(OnEffectListUpdated, &FASComponentNativeEvents::EffectListUpdated, this);
 	}
 
 	return temp;
@@ -297,11 +1349,158 @@ void UASComponent::GetEffectList(TArray<UEffect*>& OutEffects)
 	OutEffects = Effects;
 }
 
+void UASComponent::GetEffectsByInstigator(AActor* Instigator, TArray<UEffect*>& OutEffects) const
+{
+	OutEffects.Reset();
+	if (const auto* effects = EffectsByInstigator.Find(Instigator))
+	{
+		OutEffects.Append(*effects);
+	}
+}
+
+int32 UASComponent::CountEffectsByInstigator(AActor* Instigator, TSubclassOf<UEffect> EffectClass) const
+{
+	const auto* effects = EffectsByInstigator.Find(Instigator);
+	if (!effects)
+		return 0;
+
+	if (!EffectClass)
+		return effects->Num();
+
+	int32 num = 0;
+	for (const UEffect* entity : *effects)
+	{
+		num += entity->IsA(EffectClass) ? 1 : 0;
+	}
+	return num;
+}
+
+int32 UASComponent::RemoveEffectsByInstigator(AActor* Instigator, TSubclassOf<UEffect> EffectClass)
+{
+	TArray<UEffect*> targets;
+	GetEffectsByInstigator(Instigator, targets);
+
+	int32 num = 0;
+	for (UEffect* entity : targets)
+	{
+		// Earlier removals may have cascaded to this one
+		if ((EffectClass && !entity->IsA(EffectClass)) || !Effects.Contains(entity))
+			continue;
+
+		// Deferred or dropped removals leave the effect in the list
+		RemoveEffectByEntity(entity);
+		if (!Effects.Contains(entity))
+		{
+			++num;
+		}
+	}
+	return num;
+}
+
+void UASComponent::IndexEffect(UEffect* InEffect)
+{
+	IndexEntityClass(InEffect->GetClass());
+
+	const AActor* instigator = InEffect->GetInstigator();
+	if (!instigator || !GetOwner()->HasAuthority())
+		return;
+
+	const FObjectKey key(instigator);
+	EffectInstigators.Add(InEffect, key);
+	EffectsByInstigator.FindOrAdd(key).Add(InEffect);
+	if (UASIndexSubsystem* index = GetWorld()->GetSubsystem<UASIndexSubsystem>())
+	{
+		index->AddInstigatedEffect(InEffect, key);
+	}
+}
+
+void UASComponent::UnindexEffect(UEffect* InEffect)
+{
+	UnindexEntityClass(InEffect->GetClass());
+
+	FObjectKey key;
+	if (!EffectInstigators.RemoveAndCopyValue(InEffect, key))
+		return;
+
+	if (auto* effects = EffectsByInstigator.Find(key))
+	{
+		effects->RemoveSingleSwap(InEffect, false);
+		if (effects->Num() == 0)
+		{
+			EffectsByInstigator.Remove(key);
+		}
+	}
+	if (UASIndexSubsystem* index = GetWorld()->GetSubsystem<UASIndexSubsystem>())
+	{
+		index->RemoveInstigatedEffect(InEffect, key);
+	}
+}
+
+void UASComponent::IndexEntityClass(const UClass* InClass)
+{
+	if (!HasBegunPlay())
+		return;
+
+	IndexedClasses.Add(InClass);
+	if (UASIndexSubsystem* index = GetWorld()->GetSubsystem<UASIndexSubsystem>())
+	{
+		index->AddEntityClass(this, InClass);
+	}
+}
+
+void UASComponent::UnindexEntityClass(const UClass* InClass)
+{
+	if (IndexedClasses.RemoveSingleSwap(InClass, false) == 0)
+		return;
+
+	if (UASIndexSubsystem* index = GetWorld()->GetSubsystem<UASIndexSubsystem>())
+	{
+		index->RemoveEntityClass(this, InClass);
+	}
+}
+
+void UASComponent::ReindexEntityClasses()
+{
+	ClearIndexedEntityClasses();
+	for (const UEffect* entity : Effects)
+	{
+		if (IsValid(entity))
+		{
+			IndexEntityClass(entity->GetClass());
+		}
+	}
+	for (const UAttribute* entity : Attributes)
+	{
+		if (IsValid(entity))
+		{
+			IndexEntityClass(entity->GetClass());
+		}
+	}
+}
+
+void UASComponent::ClearIndexedEntityClasses()
+{
+	if (IndexedClasses.Num() == 0)
+		return;
+
+	if (UASIndexSubsystem* index = GetWorld()->GetSubsystem<UASIndexSubsystem>())
+	{
+		for (const UClass* entityClass : IndexedClasses)
+		{
+			index->RemoveEntityClass(this, entityClass);
+		}
+	}
+	IndexedClasses.Reset();
+}
+
 UAttribute* UASComponent::AddAttribute(TSubclassOf<UAttribute> AttributeClass)
 {
 	if (!AttributeClass)
 		return nullptr;
 
+	if (DeferMutation(EASPendingMutationType::AddAttribute, nullptr, AttributeClass))
+		return nullptr;
+
 	const int32 n = Attributes.Num();
 	for (int32 i = 0; i < n; ++i)
 	{
@@ -314,25 +1513,46 @@ UAttribute* UASComponent::AddAttribute(TSubclassOf<UAttribute> AttributeClass)
 	}
 	UAttribute* temp = NewObject<UAttribute>(GetOwner(), AttributeClass);
 	Attributes.Add(temp);
+	AddReplicatedEntity(temp);
+	++AttributeListVersion;
+	IndexEntityClass(temp->GetClass());
+	BindAttributeEvents(temp);
+	RecordHistory(temp->GetClass(), EASHistoryRecordType::AttributeValue, temp->GetCurrentValue());
+	AS_JOURNAL_RECORD(GetOwner(), AttributeAdded, temp->GetClass(), temp->GetCurrentValue());
 	MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Attributes, this);
+	AS_RECORD_PROPERTY_UPDATE(UASComponent, Attributes, this);
 
+	FASNotificationScope scope(this);
 	{
 		// Notify all Attributes except target (n is previous)
 		for (int32 i = 0; i < n; ++i)
 		{
-			Attributes[i]->OnAttributeAdded(temp);
-			Attributes[i]->OnAttributeListUpdated();
+			if (Attributes[i]->HasEntityHook(EASEntityHooks::AttributeAdded))
+			{
+				Attributes[i]->OnAttributeAdded(temp);
+			}
+			if (Attributes[i]->HasEntityHook(EASEntityHooks::AttributeListUpdated))
+			{
+				Attributes[i]->OnAttributeListUpdated();
+			}
 		}
 		// Notify all effects
 		for (int32 k = 0; k < Effects.Num(); ++k)
 		{
-			Effects[k]->OnAttributeAdded(temp);
-			Effects[k]->OnAttributeListUpdated();
+			if (Effects[k]->HasEntityHook(EASEntityHooks::AttributeAdded))
+			{
+				Effects[k]->OnAttributeAdded(temp);
+			}
+			if (Effects[k]->HasEntityHook(EASEntityHooks::AttributeListUpdated))
+			{
+				Effects[k]->OnAttributeListUpdated();
+			}
 		}
-		OnAttributeAdded.Broadcast(this, temp);
-		OnAttributeListUpdated.Broadcast(this);
+		BroadcastEvent(OnAttributeAdded, &FASComponentNativeEvents::AttributeAdded, this, temp);
+		BroadcastEvent(OnAttributeListUpdated, &FASComponentNativeEvents::AttributeListUpdated, this);
 	}
 
+	UpdateDerivedAttributes();
 	return temp;
 }
 
@@ -341,55 +1561,77 @@ void UASComponent::RemoveAttributeByEntity(UAttribute* InAttribute)
 	if (!IsValid(InAttribute))
 		return;
 
+	if (DeferMutation(EASPendingMutationType::RemoveAttribute, InAttribute, nullptr))
+		return;
+
 	// Iterate through the Attributes array
-	int32 n = Attributes.Num();
-	for (int32 i = 0; i < n; ++i)
+	for (int32 i = 0; i < Attributes.Num(); ++i)
 	{
 		UAttribute*& entity = Attributes[i];
 
 		// Check if the Effect's pointer matches the provided InAttribute
 		if (IsValid(entity) && InAttribute == entity)
 		{
+			FASNotificationScope scope(this);
+
 			// Notify attribute
 			entity->OnWorkEnded();
 			// Notify all attributes except target
 			{
-				for (int32 j = 0; j < n; ++j)
+				for (int32 j = 0; j < Attributes.Num(); ++j)
 				{
 					if (j != i)
 					{
-						Attributes[j]->OnAttributeRemoving(entity);
+						if (Attributes[j]->HasEntityHook(EASEntityHooks::AttributeRemoving))
+						{
+							Attributes[j]->OnAttributeRemoving(entity);
+						}
 					}
 				}
 				// Notify all effects
 				for (int32 k = 0; k < Effects.Num(); ++k)
 				{
-					Effects[k]->OnAttributeRemoving(entity);
+					if (Effects[k]->HasEntityHook(EASEntityHooks::AttributeRemoving))
+					{
+						Effects[k]->OnAttributeRemoving(entity);
+					}
 				}
-				OnAttributeRemoved.Broadcast(this, entity);
+				BroadcastEvent(OnAttributeRemoved, &FASComponentNativeEvents::AttributeRemoved, this, entity);
 			}
 
+			AS_JOURNAL_RECORD(GetOwner(), AttributeRemoved, entity->GetClass(), 0.0f);
+			UnindexEntityClass(entity->GetClass());
 
 			// Memory cleanup
+			RemoveReplicatedEntity(entity);
 			entity->ConditionalBeginDestroy();
 			entity = nullptr;
 
 			// Remove it from the array
 			Attributes.RemoveAt(i);
+			++AttributeListVersion;
 			MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Attributes, this);
+			AS_RECORD_PROPERTY_UPDATE(UASComponent, Attributes, this);
 			{
 				for (int32 j = 0; j < Effects.Num(); ++j)
 				{
-					Effects[j]->OnAttributeListUpdated();
+					if (Effects[j]->HasEntityHook(EASEntityHooks::AttributeListUpdated))
+					{
+						Effects[j]->OnAttributeListUpdated();
+					}
 				}
 
 				for (int32 j = 0; j < Attributes.Num(); ++j)
 				{
-					Attributes[j]->OnAttributeListUpdated();
+					if (Attributes[j]->HasEntityHook(EASEntityHooks::AttributeListUpdated))
+					{
+						Attributes[j]->OnAttributeListUpdated();
+					}
 				}
-				OnAttributeListUpdated.Broadcast(this);
+				BroadcastEvent(OnAttributeListUpdated, &FASComponentNativeEvents::AttributeListUpdated, this);
 			}
 
+			UpdateDerivedAttributes();
 			return;
 		}
 	}
@@ -400,58 +1642,81 @@ void UASComponent::RemoveAttributeByClass(TSubclassOf<UAttribute> AttributeClass
 	if (!AttributeClass)
 		return;
 
+	if (DeferMutation(EASPendingMutationType::RemoveAttributeByClass, nullptr, AttributeClass))
+		return;
+
 	// Iterate through the Attribute array
-	int32 n = Attributes.Num();
-	for (int32 i = 0; i < n; ++i)
+	for (int32 i = 0; i < Attributes.Num(); ++i)
 	{
 		UAttribute*& entity = Attributes[i];
 
 		// Check if the Attribute's class matches the provided AttributeClass
 		if (IsValid(entity) && entity->IsA(AttributeClass))
 		{
+			FASNotificationScope scope(this);
+
 			// Notify effect
 			entity->OnWorkEnded();
 
 			{
 				// Notify all attributes except target
-				for (int32 j = 0; j < n; ++j)
+				for (int32 j = 0; j < Attributes.Num(); ++j)
 				{
 					if (j != i)
 					{
-						Attributes[j]->OnAttributeRemoving(entity);
+						if (Attributes[j]->HasEntityHook(EASEntityHooks::AttributeRemoving))
+						{
+							Attributes[j]->OnAttributeRemoving(entity);
+						}
 					}
 				}
 				// Notify all effects
 				for (int32 k = 0; k < Effects.Num(); ++k)
 				{
-					Effects[k]->OnAttributeRemoving(entity);
+					if (Effects[k]->HasEntityHook(EASEntityHooks::AttributeRemoving))
+					{
+						Effects[k]->OnAttributeRemoving(entity);
+					}
 				}
 
-				OnAttributeRemoved.Broadcast(this, entity);
+				BroadcastEvent(OnAttributeRemoved, &FASComponentNativeEvents::AttributeRemoved, this, entity);
 			}
 
+			AS_JOURNAL_RECORD(GetOwner(), AttributeRemoved, entity->GetClass(), 0.0f);
+			UnindexEntityClass(entity->GetClass());
 
 			// Memory cleanup
+			RemoveReplicatedEntity(entity);
 			entity->ConditionalBeginDestroy();
 			entity = nullptr;
 
 			// Remove it from the array
 			Attributes.RemoveAt(i);
+			++AttributeListVersion;
 			MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Attributes, this);
+			AS_RECORD_PROPERTY_UPDATE(UASComponent, Attributes, this);
 
 			{
 				for (int32 j = 0; j < Attributes.Num(); ++j)
 				{
-					Attributes[j]->OnAttributeListUpdated();
+					if (Attributes[j]->HasEntityHook(EASEntityHooks::AttributeListUpdated))
+					{
+						Attributes[j]->OnAttributeListUpdated();
+					}
 				}
 				
 				for (int32 j = 0; j < Effects.Num(); ++j)
 				{
-					Effects[j]->OnAttributeListUpdated();
+					if (Effects[j]->HasEntityHook(EASEntityHooks::AttributeListUpdated))
+					{
+						Effects[j]->OnAttributeListUpdated();
+					}
 				}
 				
-				OnAttributeListUpdated.Broadcast(this);
+				BroadcastEvent(OnAttributeListUpdated, &FASComponentNativeEvents::AttributeListUpdated, this);
 			}
+
+			UpdateDerivedAttributes();
 			return;
 		}
 	}
@@ -488,3 +1753,202 @@ void UASComponent::GetAttributeList(TArray<UAttribute*>& OutAttributes)
 {
 	OutAttributes = Attributes;
 }
+
+UAbility* UASComponent::AddAbility(TSubclassOf<UAbility> AbilityClass)
+{
+	if (!AbilityClass)
+		return nullptr;
+
+	if (HasAbility(AbilityClass))
+		return nullptr;
+
+	UAbility* temp = NewObject<UAbility>(GetOwner(), AbilityClass);
+	Abilities.Add(temp);
+	AddReplicatedEntity(temp);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Abilities, this);
+	AS_RECORD_PROPERTY_UPDATE(UASComponent, Abilities, this);
+	++AbilityListRevision;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, AbilityListRevision, this);
+	AS_RECORD_PROPERTY_UPDATE(UASComponent, AbilityListRevision, this);
+
+	BroadcastEvent(OnAbilityAdded, &FASComponentNativeEvents::AbilityAdded, this, temp);
+	BroadcastEvent(OnAbilityListUpdated, &FASComponentNativeEvents::AbilityListUpdated, this);
+	return temp;
+}
+
+void UASComponent::RemoveAbilityByEntity(UAbility* InAbility)
+{
+	if (!IsValid(InAbility))
+		return;
+
+	const int32 index = Abilities.Find(InAbility);
+	if (index == INDEX_NONE)
+		return;
+
+	InAbility->OnRemoved();
+	BroadcastEvent(OnAbilityRemoved, &FASComponentNativeEvents::AbilityRemoved, this, InAbility);
+
+	// Memory cleanup
+	RemoveReplicatedEntity(InAbility);
+	InAbility->ConditionalBeginDestroy();
+
+	// Remove it from the array
+	Abilities.RemoveAt(index);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, Abilities, this);
+	AS_RECORD_PROPERTY_UPDATE(UASComponent, Abilities, this);
+	++AbilityListRevision;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UASComponent, AbilityListRevision, this);
+	AS_RECORD_PROPERTY_UPDATE(UASComponent, AbilityListRevision, this);
+
+	BroadcastEvent(OnAbilityListUpdated, &FASComponentNativeEvents::AbilityListUpdated, this);
+}
+
+void UASComponent::RemoveAbilityByClass(TSubclassOf<UAbility> AbilityClass)
+{
+	RemoveAbilityByEntity(Ability(AbilityClass));
+}
+
+UAbility* UASComponent::GetAbility(TSubclassOf<UAbility> AbilityClass)
+{
+	return Ability(AbilityClass);
+}
+
+UAbility* UASComponent::Ability(TSubclassOf<UAbility> AbilityClass) const
+{
+	if (!AbilityClass)
+		return nullptr;
+
+	for (UAbility* entity : Abilities)
+	{
+		if (IsValid(entity) && entity->IsA(AbilityClass))
+		{
+			return entity;
+		}
+	}
+	return nullptr;
+}
+
+bool UASComponent::HasAbility(TSubclassOf<UAbility> AbilityClass) const
+{
+	return IsValid(Ability(AbilityClass));
+}
+
+bool UASComponent::CanActivateAbility(TSubclassOf<UAbility> AbilityClass) const
+{
+	const UAbility* entity = Ability(AbilityClass);
+	return IsValid(entity) && entity->CanActivate();
+}
+
+bool UASComponent::TryActivateAbility(TSubclassOf<UAbility> AbilityClass)
+{
+	if (!GetOwner()->HasAuthority())
+		return false;
+
+	UAbility* entity = Ability(AbilityClass);
+	if (!IsValid(entity) || !entity->TryActivate())
+		return false;
+
+	BroadcastEvent(OnAbilityActivated, &FASComponentNativeEvents::AbilityActivated, this, entity);
+	return true;
+}
+
+int32 UASComponent::RequestActivateAbility(TSubclassOf<UAbility> AbilityClass)
+{
+	// Nothing to predict on the server, there is no key a rejection could refer to
+	if (GetOwner()->HasAuthority())
+	{
+		TryActivateAbility(AbilityClass);
+		return 0;
+	}
+
+	const int32 index = Abilities.IndexOfByPredicate([AbilityClass](const UAbility* entity)
+	{
+		return IsValid(entity) && entity->IsA(AbilityClass);
+	});
+
+	// Index must fit the request, a failing local check would be rejected anyway
+	if (index == INDEX_NONE || index > MAX_uint8 || !Abilities[index]->CanActivate())
+		return 0;
+
+	if (++LastPredictionKey == 0)
+	{
+		LastPredictionKey = 1;
+	}
+
+	FASAbilityActivationRequest& request = PendingActivations.AddDefaulted_GetRef();
+	request.AbilityIndex = static_cast<uint8>(index);
+	request.PredictionKey = LastPredictionKey;
+	return LastPredictionKey;
+}
+
+void UASComponent::FlushActivationRequests()
+{
+	ActivationFlushAccumulator = 0.0f;
+	if (PendingActivations.Num() == 0)
+		return;
+
+	if (PendingActivations.Num() <= MaxActivationsPerBatch)
+	{
+		Server_ActivateAbilities(AbilityListRevision, PendingActivations);
+		PendingActivations.Reset();
+		return;
+	}
+
+	// Rest goes with the next batch
+	TArray<FASAbilityActivationRequest> batch(PendingActivations.GetData(), MaxActivationsPerBatch);
+	PendingActivations.RemoveAt(0, MaxActivationsPerBatch, false);
+	Server_ActivateAbilities(AbilityListRevision, batch);
+}
+
+void UASComponent::Server_ActivateAbilities_Implementation(uint8 InRevision,
+                                                           const TArray<FASAbilityActivationRequest>& InRequests)
+{
+	TArray<uint16, TInlineAllocator<16>> rejected;
+	const bool bRevisionMatches = InRevision == AbilityListRevision;
+
+	// Clients never send more, anything above the limit is dropped without a reply
+	const int32 n = FMath::Min(InRequests.Num(), MaxActivationsPerBatch);
+	for (int32 i = 0; i < n; ++i)
+	{
+		const FASAbilityActivationRequest& request = InRequests[i];
+		UAbility* entity = bRevisionMatches && Abilities.IsValidIndex(request.AbilityIndex)
+			                   ? Abilities[request.AbilityIndex]
+			                   : nullptr;
+
+		if (IsValid(entity) && entity->TryActivate())
+		{
+			BroadcastEvent(OnAbilityActivated, &FASComponentNativeEvents::AbilityActivated, this, entity);
+		}
+		else
+		{
+			rejected.Add(request.PredictionKey);
+		}
+	}
+
+	if (rejected.Num() > 0)
+	{
+		Client_RejectActivations(TArray<uint16>(rejected));
+	}
+}
+
+void UASComponent::Client_RejectActivations_Implementation(const TArray<uint16>& InPredictionKeys)
+{
+	for (const uint16 key : InPredictionKeys)
+	{
+		OnAbilityActivationRejected.Broadcast(this, key);
+	}
+}
+
+FASComponentNativeEvents& UASComponent::GetNativeEvents()
+{
+	if (!NativeEvents.IsValid())
+	{
+		NativeEvents = MakeUnique<FASComponentNativeEvents>();
+	}
+	return *NativeEvents;
+}
+
+void UASComponent::GetAbilityList(TArray<UAbility*>& OutAbilities)
+{
+	OutAbilities = Abilities;
+}
@@ -0,0 +1,217 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Derived/ASDerivedAttributeGraph.h"
+
+#include "AbilitySystem.h"
+#include "Components/ASComponent.h"
+#include "Objects/Attribute.h"
+
+void FASDerivedAttributeGraph::Build(const TArray<FASDerivedAttributeRule>& InRules, const UObject* InContext)
+{
+	Nodes.Reset();
+	Readers.Reset();
+	Dirty.Reset();
+	NumDirty = 0;
+	ResolvedVersion = 0;
+	bBuilt = true;
+
+	const int32 n = InRules.Num();
+
+	// Rule j depends on rule i if j reads the target of i
+	TArray<TArray<int32, TInlineAllocator<4>>> dependents;
+	dependents.SetNum(n);
+	TArray<int32> inDegree;
+	inDegree.SetNumZeroed(n);
+	for (int32 i = 0; i < n; ++i)
+	{
+		if (!InRules[i].Target)
+			continue;
+
+		for (int32 j = 0; j < n; ++j)
+		{
+			const bool bReads = InRules[j].Sources.ContainsByPredicate([&](const FASDerivedAttributeSource& source)
+			{
+				return source.Attribute && (source.Attribute->IsChildOf(InRules[i].Target) ||
+					InRules[i].Target->IsChildOf(source.Attribute));
+			});
+			if (bReads)
+			{
+				dependents[i].Add(j);
+				++inDegree[j];
+			}
+		}
+	}
+
+	// Kahn's algorithm, ties are kept in declaration order
+	TArray<int32> order;
+	order.Reserve(n);
+	for (int32 i = 0; i < n; ++i)
+	{
+		if (inDegree[i] == 0)
+		{
+			order.Add(i);
+		}
+	}
+	for (int32 k = 0; k < order.Num(); ++k)
+	{
+		for (const int32 j : dependents[order[k]])
+		{
+			if (--inDegree[j] == 0)
+			{
+				order.Add(j);
+			}
+		}
+	}
+
+	if (order.Num() != n)
+	{
+		for (int32 i = 0; i < n; ++i)
+		{
+			if (inDegree[i] > 0)
+			{
+				UE_LOG(LogAbilitySystem, Error, TEXT("%s: derived attribute rule %d (%s) is part of a cycle, ignored"),
+				       *GetPathNameSafe(InContext), i, *GetNameSafe(InRules[i].Target));
+			}
+		}
+	}
+
+	Nodes.Reserve(order.Num());
+	for (const int32 i : order)
+	{
+		const FASDerivedAttributeRule& rule = InRules[i];
+		if (!rule.Target)
+			continue;
+
+		FNode& node = Nodes.AddDefaulted_GetRef();
+		node.TargetClass = rule.Target;
+		node.Field = rule.Field;
+		node.BaseValue = rule.BaseValue;
+		for (const FASDerivedAttributeSource& source : rule.Sources)
+		{
+			if (source.Attribute)
+			{
+				node.Sources.Add(FSource{source.Attribute, source.Coefficient, nullptr});
+			}
+		}
+	}
+	Dirty.Init(false, Nodes.Num());
+}
+
+void FASDerivedAttributeGraph::Resolve(const UASComponent* InComponent)
+{
+	Readers.Reset();
+	const int32 n = Nodes.Num();
+	for (int32 i = 0; i < n; ++i)
+	{
+		FNode& node = Nodes[i];
+		node.Target = InComponent->Attribute(const_cast<UClass*>(node.TargetClass));
+		for (FSource& source : node.Sources)
+		{
+			source.Attribute = InComponent->Attribute(const_cast<UClass*>(source.Class));
+			if (source.Attribute)
+			{
+				Readers.FindOrAdd(source.Attribute).AddUnique(i);
+			}
+		}
+	}
+
+	Dirty.Init(true, n);
+	NumDirty = n;
+	ResolvedVersion = InComponent->GetAttributeListVersion();
+}
+
+void FASDerivedAttributeGraph::MarkChanged(const UAttribute* InAttribute)
+{
+	if (const auto* readers = Readers.Find(InAttribute))
+	{
+		for (const int32 i : *readers)
+		{
+			if (!Dirty[i])
+			{
+				Dirty[i] = true;
+				++NumDirty;
+			}
+		}
+	}
+}
+
+int32 FASDerivedAttributeGraph::Evaluate()
+{
+	int32 computed = 0;
+	const int32 n = Nodes.Num();
+
+	// Writing a target marks only later nodes, a single pass is enough
+	for (int32 i = 0; i < n && NumDirty > 0; ++i)
+	{
+		if (!Dirty[i])
+			continue;
+
+		Dirty[i] = false;
+		--NumDirty;
+		++computed;
+
+		FNode& node = Nodes[i];
+		if (!IsValid(node.Target))
+			continue;
+
+		float value = node.BaseValue;
+		for (const FSource& source : node.Sources)
+		{
+			if (IsValid(source.Attribute))
+			{
+				value += source.Attribute->GetCurrentValue() * source.Coefficient;
+			}
+		}
+
+		switch (node.Field)
+		{
+		case EASDerivedAttributeField::CurrentValue:
+			if (node.Target->GetCurrentValue() != value)
+			{
+				node.Target->SetValue(value);
+			}
+			break;
+		case EASDerivedAttributeField::MaxValue:
+			if (node.Target->GetMaxValue() != value)
+			{
+				node.Target->SetMaxValue(value);
+			}
+			break;
+		case EASDerivedAttributeField::MinValue:
+			if (node.Target->GetMinValue() != value)
+			{
+				node.Target->SetMinValue(value);
+			}
+			break;
+		}
+	}
+	return computed;
+}
+
+SIZE_T FASDerivedAttributeGraph::GetAllocatedSize() const
+{
+	SIZE_T size = Nodes.GetAllocatedSize() + Readers.GetAllocatedSize() + Dirty.GetAllocatedSize();
+	for (const FNode& node : Nodes)
+	{
+		size += node.Sources.GetAllocatedSize();
+	}
+	for (const auto& pair : Readers)
+	{
+		size += pair.Value.GetAllocatedSize();
+	}
+	return size;
+}
+
+bool FASDerivedAttributeGraph::IsSource(const UClass* InClass) const
+{
+	for (const FNode& node : Nodes)
+	{
+		for (const FSource& source : node.Sources)
+		{
+			if (InClass->IsChildOf(source.Class))
+				return true;
+		}
+	}
+	return false;
+}
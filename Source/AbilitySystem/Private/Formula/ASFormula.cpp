@@ -0,0 +1,417 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Formula/ASFormula.h"
+
+#include "AbilitySystem.h"
+#include "Objects/Attribute.h"
+
+/**
+ * @class FASFormulaCompiler
+ * @brief Recursive descent parser emitting postfix bytecode.
+ *
+ * expression := term (('+' | '-') term)*
+ * term       := unary (('*' | '/') unary)*
+ * unary      := '-' unary | power
+ * power      := primary ('^' unary)?
+ * primary    := number | identifier | identifier '(' arguments ')' | '(' expression ')'
+ */
+class FASFormulaCompiler
+{
+public:
+	FASFormulaCompiler(const FString& InExpression, TArrayView<const FName> InAttributeNames,
+	                   FASFormulaProgram& OutProgram)
+		: Text(*InExpression), Length(InExpression.Len()), AttributeNames(InAttributeNames), Program(OutProgram)
+	{
+	}
+
+	bool Run(FString& OutError)
+	{
+		ParseExpression();
+		SkipSpaces();
+		if (Error.IsEmpty() && Position < Length)
+		{
+			Fail(TEXT("unexpected character"));
+		}
+		OutError = Error;
+		return Error.IsEmpty();
+	}
+
+private:
+	void Fail(const TCHAR* InMessage)
+	{
+		if (Error.IsEmpty())
+		{
+			Error = FString::Printf(TEXT("%s at %d"), InMessage, Position);
+		}
+	}
+
+	void SkipSpaces()
+	{
+		while (Position < Length && FChar::IsWhitespace(Text[Position]))
+		{
+			++Position;
+		}
+	}
+
+	bool Match(TCHAR InChar)
+	{
+		SkipSpaces();
+		if (Position < Length && Text[Position] == InChar)
+		{
+			++Position;
+			return true;
+		}
+		return false;
+	}
+
+	void Emit(FASFormulaProgram::EOp InOp, int32 InArity, uint16 InOperand = 0)
+	{
+		// Every instruction pops its arguments and pushes one value
+		StackSize += 1 - InArity;
+		Program.MaxStackSize = FMath::Max(Program.MaxStackSize, StackSize);
+		Program.Instructions.Add({InOp, InOperand});
+	}
+
+	void ParseExpression()
+	{
+		ParseTerm();
+		while (Error.IsEmpty())
+		{
+			if (Match(TEXT('+')))
+			{
+				ParseTerm();
+				Emit(FASFormulaProgram::EOp::Add, 2);
+			}
+			else if (Match(TEXT('-')))
+			{
+				ParseTerm();
+				Emit(FASFormulaProgram::EOp::Subtract, 2);
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	void ParseTerm()
+	{
+		ParseUnary();
+		while (Error.IsEmpty())
+		{
+			if (Match(TEXT('*')))
+			{
+				ParseUnary();
+				Emit(FASFormulaProgram::EOp::Multiply, 2);
+			}
+			else if (Match(TEXT('/')))
+			{
+				ParseUnary();
+				Emit(FASFormulaProgram::EOp::Divide, 2);
+			}
+			else
+			{
+				break;
+			}
+		}
+	}
+
+	void ParseUnary()
+	{
+		if (Match(TEXT('-')))
+		{
+			ParseUnary();
+			Emit(FASFormulaProgram::EOp::Negate, 1);
+			return;
+		}
+		ParsePower();
+	}
+
+	void ParsePower()
+	{
+		ParsePrimary();
+		if (Error.IsEmpty() && Match(TEXT('^')))
+		{
+			// Right associative, binds tighter than a leading minus: -2^2 is -(2^2)
+			ParseUnary();
+			Emit(FASFormulaProgram::EOp::Power, 2);
+		}
+	}
+
+	void ParsePrimary()
+	{
+		if (!Error.IsEmpty())
+			return;
+
+		SkipSpaces();
+		if (Position >= Length)
+		{
+			Fail(TEXT("unexpected end of expression"));
+			return;
+		}
+
+		if (Match(TEXT('(')))
+		{
+			ParseExpression();
+			if (!Match(TEXT(')')))
+			{
+				Fail(TEXT("')' expected"));
+			}
+			return;
+		}
+
+		const TCHAR c = Text[Position];
+		if (FChar::IsDigit(c) || c == TEXT('.'))
+		{
+			ParseNumber();
+			return;
+		}
+
+		if (FChar::IsAlpha(c) || c == TEXT('_'))
+		{
+			ParseIdentifier();
+			return;
+		}
+
+		Fail(TEXT("unexpected character"));
+	}
+
+	void ParseNumber()
+	{
+		const int32 start = Position;
+		while (Position < Length && (FChar::IsDigit(Text[Position]) || Text[Position] == TEXT('.')))
+		{
+			++Position;
+		}
+
+		const FString number(Position - start, Text + start);
+		if (!number.IsNumeric())
+		{
+			Fail(TEXT("invalid number"));
+			return;
+		}
+
+		const float value = FCString::Atof(*number);
+		int32 index = Program.Constants.Find(value);
+		if (index == INDEX_NONE)
+		{
+			index = Program.Constants.Add(value);
+		}
+		Emit(FASFormulaProgram::EOp::Constant, 0, static_cast<uint16>(index));
+	}
+
+	void ParseIdentifier()
+	{
+		const int32 start = Position;
+		while (Position < Length && (FChar::IsAlnum(Text[Position]) || Text[Position] == TEXT('_')))
+		{
+			++Position;
+		}
+		const FString identifier(Position - start, Text + start);
+
+		if (Match(TEXT('(')))
+		{
+			ParseFunction(identifier);
+			return;
+		}
+
+		if (identifier.Equals(TEXT("Stacks"), ESearchCase::IgnoreCase))
+		{
+			Emit(FASFormulaProgram::EOp::Stacks, 0);
+			return;
+		}
+		if (identifier.Equals(TEXT("Level"), ESearchCase::IgnoreCase))
+		{
+			Emit(FASFormulaProgram::EOp::Level, 0);
+			return;
+		}
+
+		// FName comparison is case-insensitive
+		const int32 slot = AttributeNames.IndexOfByKey(FName(*identifier));
+		if (slot == INDEX_NONE)
+		{
+			Fail(TEXT("unknown identifier"));
+			return;
+		}
+		Program.bReadsAttributes = true;
+		Emit(FASFormulaProgram::EOp::Attribute, 0, static_cast<uint16>(slot));
+	}
+
+	void ParseFunction(const FString& InName)
+	{
+		struct FFunction
+		{
+			const TCHAR* Name;
+			FASFormulaProgram::EOp Op;
+			int32 Arity;
+		};
+		static const FFunction functions[] = {
+			{TEXT("min"), FASFormulaProgram::EOp::Min, 2},
+			{TEXT("max"), FASFormulaProgram::EOp::Max, 2},
+			{TEXT("abs"), FASFormulaProgram::EOp::Abs, 1},
+			{TEXT("clamp"), FASFormulaProgram::EOp::Clamp, 3},
+			{TEXT("floor"), FASFormulaProgram::EOp::Floor, 1},
+			{TEXT("ceil"), FASFormulaProgram::EOp::Ceil, 1},
+			{TEXT("sqrt"), FASFormulaProgram::EOp::Sqrt, 1},
+		};
+
+		const FFunction* function = nullptr;
+		for (const FFunction& entry : functions)
+		{
+			if (InName.Equals(entry.Name, ESearchCase::IgnoreCase))
+			{
+				function = &entry;
+				break;
+			}
+		}
+		if (!function)
+		{
+			Fail(TEXT("unknown function"));
+			return;
+		}
+
+		for (int32 i = 0; i < function->Arity && Error.IsEmpty(); ++i)
+		{
+			if (i > 0 && !Match(TEXT(',')))
+			{
+				Fail(TEXT("',' expected"));
+				return;
+			}
+			ParseExpression();
+		}
+		if (Error.IsEmpty() && !Match(TEXT(')')))
+		{
+			Fail(TEXT("')' expected"));
+			return;
+		}
+		Emit(function->Op, function->Arity);
+	}
+
+private:
+	const TCHAR* Text;
+	int32 Length;
+	int32 Position = 0;
+	TArrayView<const FName> AttributeNames;
+	FASFormulaProgram& Program;
+	int32 StackSize = 0;
+	FString Error;
+};
+
+TSharedPtr<const FASFormulaProgram> FASFormulaProgram::Compile(const FString& InExpression,
+                                                               TArrayView<const FName> InAttributeNames,
+                                                               FString& OutError)
+{
+	TSharedPtr<FASFormulaProgram> program = MakeShared<FASFormulaProgram>();
+	FASFormulaCompiler compiler(InExpression, InAttributeNames, *program);
+	if (!compiler.Run(OutError))
+		return nullptr;
+
+	program->Instructions.Shrink();
+	program->Constants.Shrink();
+	return program;
+}
+
+float FASFormulaProgram::Execute(const FASFormulaContext& InContext) const
+{
+	TArray<float, TInlineAllocator<16>> stack;
+	stack.SetNumUninitialized(MaxStackSize);
+	int32 top = -1;
+
+	for (const FInstruction& instruction : Instructions)
+	{
+		switch (instruction.Op)
+		{
+		case EOp::Constant:
+			stack[++top] = Constants[instruction.Operand];
+			break;
+		case EOp::Attribute:
+			{
+				const UAttribute* attribute = InContext.Attributes.IsValidIndex(instruction.Operand)
+					                              ? InContext.Attributes[instruction.Operand]
+					                              : nullptr;
+				stack[++top] = attribute ? attribute->GetCurrentValue() : 0.0f;
+			}
+			break;
+		case EOp::Stacks:
+			stack[++top] = InContext.Stacks;
+			break;
+		case EOp::Level:
+			stack[++top] = InContext.Level;
+			break;
+		case EOp::Negate:
+			stack[top] = -stack[top];
+			break;
+		case EOp::Add:
+			--top;
+			stack[top] += stack[top + 1];
+			break;
+		case EOp::Subtract:
+			--top;
+			stack[top] -= stack[top + 1];
+			break;
+		case EOp::Multiply:
+			--top;
+			stack[top] *= stack[top + 1];
+			break;
+		case EOp::Divide:
+			--top;
+			stack[top] = stack[top + 1] != 0.0f ? stack[top] / stack[top + 1] : 0.0f;
+			break;
+		case EOp::Power:
+			--top;
+			stack[top] = FMath::Pow(stack[top], stack[top + 1]);
+			break;
+		case EOp::Min:
+			--top;
+			stack[top] = FMath::Min(stack[top], stack[top + 1]);
+			break;
+		case EOp::Max:
+			--top;
+			stack[top] = FMath::Max(stack[top], stack[top + 1]);
+			break;
+		case EOp::Abs:
+			stack[top] = FMath::Abs(stack[top]);
+			break;
+		case EOp::Clamp:
+			top -= 2;
+			stack[top] = FMath::Clamp(stack[top], stack[top + 1], stack[top + 2]);
+			break;
+		case EOp::Floor:
+			stack[top] = FMath::FloorToFloat(stack[top]);
+			break;
+		case EOp::Ceil:
+			stack[top] = FMath::CeilToFloat(stack[top]);
+			break;
+		case EOp::Sqrt:
+			stack[top] = FMath::Sqrt(FMath::Max(stack[top], 0.0f));
+			break;
+		}
+	}
+	return top >= 0 ? stack[top] : 0.0f;
+}
+
+bool FASFormula::Compile(const UObject* InContext)
+{
+	Program.Reset();
+	bCompileFailed = false;
+	if (Expression.IsEmpty())
+		return false;
+
+	TArray<FName, TInlineAllocator<8>> names;
+	for (const FASFormulaAttribute& attribute : Attributes)
+	{
+		names.Add(attribute.Name);
+	}
+
+	FString error;
+	Program = FASFormulaProgram::Compile(Expression, names, error);
+	if (!Program.IsValid())
+	{
+		bCompileFailed = true;
+		UE_LOG(LogAbilitySystem, Error, TEXT("%s: formula '%s' is invalid: %s"), *GetPathNameSafe(InContext),
+		       *Expression, *error);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,42 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "History/ASHistoryBuffer.h"
+
+void FASHistoryBuffer::Init(int32 InCapacity)
+{
+	Records.Empty(InCapacity);
+	Records.SetNum(FMath::Max(InCapacity, 0));
+	Reset();
+}
+
+void FASHistoryBuffer::Reset()
+{
+	Head = 0;
+	Count = 0;
+	bWrapped = false;
+}
+
+bool FASHistoryBuffer::Covers(double InTime) const
+{
+	return !bWrapped || InTime >= GetFromNewest(Count - 1).Time;
+}
+
+void FASHistoryBuffer::Add(const FASHistoryRecord& InRecord)
+{
+	const int32 capacity = Records.Num();
+	if (capacity == 0)
+		return;
+
+	Records[Head] = InRecord;
+	Head = (Head + 1) % capacity;
+
+	if (Count < capacity)
+	{
+		++Count;
+	}
+	else
+	{
+		bWrapped = true;
+	}
+}
@@ -0,0 +1,36 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Journal/ASJournal.h"
+
+void FASJournalRingBuffer::Init(uint32 InCapacity)
+{
+	Capacity = InCapacity > 0 ? FMath::RoundUpToPowerOfTwo(InCapacity) : 0;
+	Mask = Capacity > 0 ? Capacity - 1 : 0;
+
+	Records.Empty(Capacity);
+	Records.SetNum(Capacity);
+	Head.store(0, std::memory_order_relaxed);
+	Tail.store(0, std::memory_order_relaxed);
+}
+
+int32 FASJournalRingBuffer::Pop(TArray<FASJournalRecord>& OutRecords)
+{
+	const uint32 tail = Tail.load(std::memory_order_relaxed);
+	const uint32 head = Head.load(std::memory_order_acquire);
+	const uint32 num = head - tail;
+	if (num == 0)
+		return 0;
+
+	// Unread records may wrap around the end of the storage
+	const uint32 start = tail & Mask;
+	const uint32 first = FMath::Min(num, Capacity - start);
+	OutRecords.Append(&Records[start], first);
+	if (first < num)
+	{
+		OutRecords.Append(Records.GetData(), num - first);
+	}
+
+	Tail.store(head, std::memory_order_release);
+	return static_cast<int32>(num);
+}
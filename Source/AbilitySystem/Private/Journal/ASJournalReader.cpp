@@ -0,0 +1,150 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Journal/ASJournalReader.h"
+
+#include "AbilitySystem.h"
+#include "HAL/FileManager.h"
+
+bool FASJournalReader::Load(const FString& InFilePath)
+{
+	ActorNames.Reset();
+	ClassNames.Reset();
+	Records.Reset();
+
+	TUniquePtr<FArchive> reader(IFileManager::Get().CreateFileReader(*InFilePath));
+	if (!reader)
+		return false;
+
+	FArchive& Ar = *reader;
+
+	uint32 magic = 0;
+	uint16 version = 0;
+	int64 startTicks = 0;
+	Ar << magic;
+	Ar << version;
+	Ar << startTicks;
+
+	if (Ar.IsError() || magic != ASJournal::Magic || version > ASJournal::Version)
+		return false;
+
+	StartTime = FDateTime(startTicks);
+
+	while (!Ar.AtEnd() && !Ar.IsError())
+	{
+		uint8 chunk = 0;
+		uint32 num = 0;
+		Ar << chunk;
+		Ar.SerializeIntPacked(num);
+
+		if (chunk == static_cast<uint8>(ASJournal::EChunk::Names))
+		{
+			for (uint32 i = 0; i < num && !Ar.IsError(); ++i)
+			{
+				uint8 kind = 0;
+				uint32 id = 0;
+				FString name;
+				Ar << kind;
+				Ar << id;
+				Ar << name;
+
+				TMap<uint32, FString>& names = kind == static_cast<uint8>(EASJournalNameKind::Class)
+					                               ? ClassNames
+					                               : ActorNames;
+				names.Add(id, MoveTemp(name));
+			}
+		}
+		else if (chunk == static_cast<uint8>(ASJournal::EChunk::Records))
+		{
+			// The last chunk may be cut off if the process has died while writing it
+			const int64 remaining = (Ar.TotalSize() - Ar.Tell()) / sizeof(FASJournalRecord);
+			num = static_cast<uint32>(FMath::Min<int64>(num, remaining));
+			if (num == 0)
+				continue;
+
+			const int32 first = Records.AddUninitialized(num);
+			Ar.Serialize(&Records[first], num * sizeof(FASJournalRecord));
+		}
+		else
+		{
+			UE_LOG(LogAbilitySystem, Warning, TEXT("%s: unknown journal chunk %u, the rest is skipped"), *InFilePath,
+			       chunk);
+			break;
+		}
+	}
+
+	return true;
+}
+
+FString FASJournalReader::GetActorName(uint32 InId) const
+{
+	const FString* name = ActorNames.Find(InId);
+	return name ? *name : FString::Printf(TEXT("Actor#%u"), InId);
+}
+
+FString FASJournalReader::GetClassName(uint32 InId) const
+{
+	const FString* name = ClassNames.Find(InId);
+	return name ? *name : FString::Printf(TEXT("Class#%u"), InId);
+}
+
+bool FASJournalReader::MatchesActor(uint32 InId, const FString& InActor) const
+{
+	if (InActor.IsEmpty())
+		return true;
+
+	const FString* name = ActorNames.Find(InId);
+	if (!name)
+		return false;
+
+	// Path names end with '.ActorName'
+	return *name == InActor || (name->EndsWith(InActor) && (*name)[name->Len() - InActor.Len() - 1] == TEXT('.'));
+}
+
+void FASJournalReader::GetTimeline(const FString& InActor, TArray<FASJournalRecord>& OutRecords) const
+{
+	OutRecords.Reset();
+	for (const FASJournalRecord& record : Records)
+	{
+		if (MatchesActor(record.ActorId, InActor))
+		{
+			OutRecords.Add(record);
+		}
+	}
+}
+
+void FASJournalReader::PrintTimeline(FOutputDevice& Ar, const FString& InActor) const
+{
+	TArray<FASJournalRecord> timeline;
+	GetTimeline(InActor, timeline);
+
+	Ar.Logf(TEXT("Journal started at %s (UTC), %d of %d records"), *StartTime.ToString(), timeline.Num(),
+	        Records.Num());
+
+	for (const FASJournalRecord& record : timeline)
+	{
+		Ar.Logf(TEXT("%10.3f  %-40s  %-18s  %-40s  %g"), record.Time, *GetActorName(record.ActorId),
+		        LexToString(record.Type), *GetClassName(record.ClassId), record.Value);
+	}
+}
+
+const TCHAR* FASJournalReader::LexToString(EASJournalRecordType InType)
+{
+	switch (InType)
+	{
+	case EASJournalRecordType::EffectAdded:
+		return TEXT("EffectAdded");
+	case EASJournalRecordType::EffectStackChanged:
+		return TEXT("EffectStackChanged");
+	case EASJournalRecordType::EffectRemoved:
+		return TEXT("EffectRemoved");
+	case EASJournalRecordType::AttributeAdded:
+		return TEXT("AttributeAdded");
+	case EASJournalRecordType::AttributeRemoved:
+		return TEXT("AttributeRemoved");
+	case EASJournalRecordType::AttributeValue:
+		return TEXT("AttributeValue");
+	default:
+		return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,296 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Journal/ASJournalSubsystem.h"
+
+#include "AbilitySystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Journal/ASJournalReader.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+
+namespace ASJournalSettings
+{
+	static int32 GEnabled = 0;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("as.Journal.Enabled"),
+		GEnabled,
+		TEXT("Starts the ability system journal for every new game world.\n")
+		TEXT("0: disabled (default), 1: enabled"),
+		ECVF_Default);
+
+	static int32 GCapacity = 16384;
+	static FAutoConsoleVariableRef CVarCapacity(
+		TEXT("as.Journal.Capacity"),
+		GCapacity,
+		TEXT("Number of journal records buffered between flushes, applied when a journal starts."),
+		ECVF_Default);
+
+	static float GFlushInterval = 0.5f;
+	static FAutoConsoleVariableRef CVarFlushInterval(
+		TEXT("as.Journal.FlushInterval"),
+		GFlushInterval,
+		TEXT("Seconds between background writes of the journal. A write also starts when the buffer is half full."),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdStart(
+		TEXT("as.Journal.Start"),
+		TEXT("Starts the ability system journal of the current world.\n")
+		TEXT("Usage: as.Journal.Start [FileName] (default: Saved/AbilitySystem/Journal/<World>-<Timestamp>.asjournal)"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+			[](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+			{
+				UASJournalSubsystem* journal = World ? World->GetSubsystem<UASJournalSubsystem>() : nullptr;
+				if (!journal)
+				{
+					Ar.Logf(TEXT("Journal is not supported in this world"));
+					return;
+				}
+
+				if (journal->Start(Args.Num() > 0 ? Args[0] : FString()))
+				{
+					Ar.Logf(TEXT("Journal is written to %s"), *journal->GetFilePath());
+				}
+				else
+				{
+					Ar.Logf(TEXT("Failed to start the journal"));
+				}
+			}));
+
+	static FAutoConsoleCommandWithWorldAndArgs CmdStop(
+		TEXT("as.Journal.Stop"),
+		TEXT("Stops the ability system journal of the current world"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UASJournalSubsystem* journal = World ? World->GetSubsystem<UASJournalSubsystem>() : nullptr)
+			{
+				journal->Stop();
+			}
+		}));
+
+	static FAutoConsoleCommandWithArgsAndOutputDevice CmdReplay(
+		TEXT("as.Journal.Replay"),
+		TEXT("Prints the timeline of a journal file.\n")
+		TEXT("Usage: as.Journal.Replay <FileName> [ActorName]"),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+		{
+			if (Args.Num() == 0)
+			{
+				Ar.Logf(TEXT("Usage: as.Journal.Replay <FileName> [ActorName]"));
+				return;
+			}
+
+			const FString filePath = FPaths::IsRelative(Args[0])
+				                         ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AbilitySystem"),
+				                                           TEXT("Journal"), Args[0])
+				                         : Args[0];
+
+			FASJournalReader reader;
+			if (!reader.Load(filePath))
+			{
+				Ar.Logf(TEXT("Failed to read journal %s"), *filePath);
+				return;
+			}
+			reader.PrintTimeline(Ar, Args.Num() > 1 ? Args[1] : FString());
+		}));
+}
+
+int32 UASJournalSubsystem::NumRecording = 0;
+
+void UASJournalSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (ASJournalSettings::GEnabled != 0)
+	{
+		Start();
+	}
+}
+
+void UASJournalSubsystem::Deinitialize()
+{
+	Stop();
+	Super::Deinitialize();
+}
+
+void UASJournalSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsRecording())
+		return;
+
+	FlushAccumulator += DeltaTime;
+	if (FlushAccumulator >= ASJournalSettings::GFlushInterval || Ring.Num() >= Ring.GetCapacity() / 2)
+	{
+		LaunchFlush();
+	}
+}
+
+TStatId UASJournalSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UASJournalSubsystem, STATGROUP_Tickables);
+}
+
+bool UASJournalSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UASJournalSubsystem::Start(const FString& InFilePath)
+{
+	Stop();
+
+	FString fileName = InFilePath;
+	if (fileName.IsEmpty())
+	{
+		fileName = FString::Printf(TEXT("%s-%s.asjournal"), *GetWorld()->GetName(), *FDateTime::Now().ToString());
+	}
+	FilePath = FPaths::IsRelative(fileName)
+		           ? FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AbilitySystem"), TEXT("Journal"), fileName)
+		           : fileName;
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		UE_LOG(LogAbilitySystem, Warning, TEXT("Failed to open journal %s"), *FilePath);
+		return false;
+	}
+
+	uint32 magic = ASJournal::Magic;
+	uint16 version = ASJournal::Version;
+	int64 startTicks = FDateTime::UtcNow().GetTicks();
+	*Writer << magic;
+	*Writer << version;
+	*Writer << startTicks;
+
+	Ring.Init(FMath::Max(ASJournalSettings::GCapacity, 64));
+	ActorIds.Reset();
+	ClassIds.Reset();
+	DroppedRecords = 0;
+	FlushAccumulator = 0.0f;
+	++NumRecording;
+	return true;
+}
+
+void UASJournalSubsystem::Stop()
+{
+	if (!IsRecording())
+		return;
+
+	FlushTask.Wait();
+	WritePending();
+
+	if (DroppedRecords > 0)
+	{
+		UE_LOG(LogAbilitySystem, Warning, TEXT("Journal %s has dropped %lld records, increase 'as.Journal.Capacity'"),
+		       *FilePath, DroppedRecords);
+	}
+
+	Writer->Close();
+	Writer.Reset();
+	--NumRecording;
+}
+
+void UASJournalSubsystem::RecordEvent(const AActor* InActor, EASJournalRecordType InType, const UClass* InClass,
+                                      float InValue)
+{
+	const UWorld* world = InActor ? InActor->GetWorld() : nullptr;
+	UASJournalSubsystem* journal = world ? world->GetSubsystem<UASJournalSubsystem>() : nullptr;
+	if (journal && journal->IsRecording())
+	{
+		journal->Record(InActor, InType, InClass, InValue);
+	}
+}
+
+void UASJournalSubsystem::Record(const AActor* InActor, EASJournalRecordType InType, const UClass* InClass,
+                                 float InValue)
+{
+	check(IsInGameThread());
+
+	FASJournalRecord record;
+	record.Time = GetWorld()->GetTimeSeconds();
+	record.ActorId = FindOrAddName(ActorIds, InActor, EASJournalNameKind::Actor);
+	record.ClassId = FindOrAddName(ClassIds, InClass, EASJournalNameKind::Class);
+	record.Value = InValue;
+	record.Type = InType;
+
+	if (!Ring.Push(record))
+	{
+		++DroppedRecords;
+	}
+}
+
+uint32 UASJournalSubsystem::FindOrAddName(TMap<FObjectKey, uint32>& InIds, const UObject* InObject,
+                                          EASJournalNameKind InKind)
+{
+	if (const uint32* id = InIds.Find(InObject))
+	{
+		return *id;
+	}
+
+	const uint32 id = InIds.Num();
+	InIds.Add(InObject, id);
+
+	// Rare, only the first event of every actor and class takes the lock
+	FScopeLock lock(&PendingNamesLock);
+	PendingNames.Add(FASJournalName{GetPathNameSafe(InObject), id, InKind});
+	return id;
+}
+
+void UASJournalSubsystem::LaunchFlush()
+{
+	if (!FlushTask.IsCompleted())
+		return;
+
+	FlushAccumulator = 0.0f;
+	FlushTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+	{
+		WritePending();
+	});
+}
+
+void UASJournalSubsystem::WritePending()
+{
+	TArray<FASJournalName> names;
+	{
+		FScopeLock lock(&PendingNamesLock);
+		names = MoveTemp(PendingNames);
+		PendingNames.Reset();
+	}
+
+	// Records popped here may reference names queued after the lock above,
+	// those are written by the next flush and resolved by the reader after loading
+	WriteBuffer.Reset();
+	Ring.Pop(WriteBuffer);
+
+	FArchive& Ar = *Writer;
+	if (names.Num() > 0)
+	{
+		uint8 chunk = static_cast<uint8>(ASJournal::EChunk::Names);
+		uint32 num = names.Num();
+		Ar << chunk;
+		Ar.SerializeIntPacked(num);
+		for (FASJournalName& name : names)
+		{
+			uint8 kind = static_cast<uint8>(name.Kind);
+			Ar << kind;
+			Ar << name.Id;
+			Ar << name.Name;
+		}
+	}
+
+	if (WriteBuffer.Num() > 0)
+	{
+		uint8 chunk = static_cast<uint8>(ASJournal::EChunk::Records);
+		uint32 num = WriteBuffer.Num();
+		Ar << chunk;
+		Ar.SerializeIntPacked(num);
+		Ar.Serialize(WriteBuffer.GetData(), WriteBuffer.Num() * sizeof(FASJournalRecord));
+	}
+
+	Ar.Flush();
+}
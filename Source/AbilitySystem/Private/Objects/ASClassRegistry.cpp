@@ -0,0 +1,168 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Objects/ASClassRegistry.h"
+
+#include "AbilitySystem.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "HAL/IConsoleManager.h"
+#include "Objects/Attribute.h"
+#include "Objects/Abilities/Ability.h"
+#include "Objects/Effects/Effect.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectHash.h"
+
+namespace ASClassRegistry
+{
+	/** Index is ID - 1 */
+	TArray<FTopLevelAssetPath> Paths;
+	TArray<TWeakObjectPtr<UClass>> Classes;
+	TMap<FTopLevelAssetPath, uint16> Ids;
+	uint32 Checksum = 0;
+
+	/** ID per class object, misses included, so the path is only built once per class */
+	TMap<FObjectKey, uint16> ClassIds;
+
+	static FAutoConsoleCommandWithOutputDevice CmdDump(
+		TEXT("as.ClassRegistry.Dump"),
+		TEXT("Prints the IDs of effect, attribute and ability classes"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FASClassRegistry::Dump));
+
+	bool IsTemporaryClass(const FTopLevelAssetPath& InPath)
+	{
+		const FString name = InPath.GetAssetName().ToString();
+		return name.StartsWith(TEXT("SKEL_")) || name.StartsWith(TEXT("REINST_")) ||
+			name.StartsWith(TEXT("TRASHCLASS_"));
+	}
+}
+
+void FASClassRegistry::Build()
+{
+	check(IsInGameThread());
+
+	const UClass* baseClasses[] = {UEffect::StaticClass(), UAttribute::StaticClass(), UAbility::StaticClass()};
+
+	TSet<FTopLevelAssetPath> found;
+	TArray<FTopLevelAssetPath> basePaths;
+	for (const UClass* baseClass : baseClasses)
+	{
+		basePaths.Add(baseClass->GetClassPathName());
+		found.Add(baseClass->GetClassPathName());
+
+		// Native classes, the asset registry may not know about all of them in the editor
+		TArray<UClass*> derived;
+		GetDerivedClasses(baseClass, derived);
+		for (const UClass* derivedClass : derived)
+		{
+			if (derivedClass->HasAnyClassFlags(CLASS_Native))
+			{
+				found.Add(derivedClass->GetClassPathName());
+			}
+		}
+	}
+
+	// Blueprint classes, without loading them
+	if (IAssetRegistry* assetRegistry = IAssetRegistry::Get())
+	{
+		TSet<FTopLevelAssetPath> derived;
+		assetRegistry->GetDerivedClassNames(basePaths, TSet<FTopLevelAssetPath>(), derived);
+		found.Append(derived);
+	}
+
+	TArray<FString> sortedPaths;
+	sortedPaths.Reserve(found.Num());
+	for (const FTopLevelAssetPath& path : found)
+	{
+		if (!ASClassRegistry::IsTemporaryClass(path))
+		{
+			sortedPaths.Add(path.ToString());
+		}
+	}
+	sortedPaths.Sort();
+
+	if (sortedPaths.Num() > MAX_uint16)
+	{
+		UE_LOG(LogAbilitySystem, Warning, TEXT("Class registry: %d classes found, only %d get an ID"),
+		       sortedPaths.Num(), MAX_uint16);
+		sortedPaths.SetNum(MAX_uint16);
+	}
+
+	ASClassRegistry::Paths.Reset(sortedPaths.Num());
+	ASClassRegistry::Classes.Reset(sortedPaths.Num());
+	ASClassRegistry::Ids.Reset();
+	ASClassRegistry::ClassIds.Reset();
+	ASClassRegistry::Checksum = 0;
+	for (const FString& pathString : sortedPaths)
+	{
+		const FTopLevelAssetPath path(pathString);
+		const uint16 id = static_cast<uint16>(ASClassRegistry::Paths.Num() + 1);
+		UClass* loaded = FindObject<UClass>(path);
+		ASClassRegistry::Paths.Add(path);
+		ASClassRegistry::Classes.Add(loaded);
+		ASClassRegistry::Ids.Add(path, id);
+		if (loaded)
+		{
+			ASClassRegistry::ClassIds.Add(loaded, id);
+		}
+		ASClassRegistry::Checksum = FCrc::StrCrc32(*pathString, ASClassRegistry::Checksum);
+	}
+
+	UE_LOG(LogAbilitySystem, Log, TEXT("Class registry: %d classes, checksum %08X"), ASClassRegistry::Paths.Num(),
+	       ASClassRegistry::Checksum);
+}
+
+uint16 FASClassRegistry::GetId(const UClass* InClass)
+{
+	if (!InClass)
+		return InvalidId;
+
+	if (const uint16* cached = ASClassRegistry::ClassIds.Find(InClass))
+	{
+		return *cached;
+	}
+
+	// Loaded after the table was built
+	const uint16* id = ASClassRegistry::Ids.Find(InClass->GetClassPathName());
+	const uint16 result = id ? *id : InvalidId;
+	ASClassRegistry::ClassIds.Add(InClass, result);
+	return result;
+}
+
+UClass* FASClassRegistry::GetClass(uint16 InId)
+{
+	const int32 index = static_cast<int32>(InId) - 1;
+	if (!ASClassRegistry::Paths.IsValidIndex(index))
+		return nullptr;
+
+	UClass* loaded = ASClassRegistry::Classes[index].Get();
+	if (!loaded)
+	{
+		loaded = FSoftClassPath(ASClassRegistry::Paths[index].ToString()).TryLoadClass<UObject>();
+		ASClassRegistry::Classes[index] = loaded;
+		if (loaded)
+		{
+			ASClassRegistry::ClassIds.Add(loaded, InId);
+		}
+	}
+	return loaded;
+}
+
+int32 FASClassRegistry::Num()
+{
+	return ASClassRegistry::Paths.Num();
+}
+
+uint32 FASClassRegistry::GetChecksum()
+{
+	return ASClassRegistry::Checksum;
+}
+
+void FASClassRegistry::Dump(FOutputDevice& Ar)
+{
+	Ar.Logf(TEXT("%d classes, checksum %08X"), ASClassRegistry::Paths.Num(), ASClassRegistry::Checksum);
+	for (int32 i = 0; i < ASClassRegistry::Paths.Num(); ++i)
+	{
+		Ar.Logf(TEXT("%5d %s"), i + 1, *ASClassRegistry::Paths[i].ToString());
+	}
+}
@@ -0,0 +1,92 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Objects/ASEntityHooks.h"
+
+#include "Objects/BasicAsEntity.h"
+#include "UObject/ObjectKey.h"
+
+namespace ASEntityHooks
+{
+	TMap<FObjectKey, EASEntityHooks> Cache;
+
+	struct FHookFunction
+	{
+		const TCHAR* Name;
+		EASEntityHooks Hook;
+	};
+
+	const FHookFunction Functions[] = {
+		{TEXT("OnAttributeListUpdated"), EASEntityHooks::AttributeListUpdated},
+		{TEXT("OnAttributeAdded"), EASEntityHooks::AttributeAdded},
+		{TEXT("OnAttributeRemoving"), EASEntityHooks::AttributeRemoving},
+		{TEXT("OnEffectListUpdated"), EASEntityHooks::EffectListUpdated},
+		{TEXT("OnEffectAdded"), EASEntityHooks::EffectAdded},
+		{TEXT("OnEffectRemoving"), EASEntityHooks::EffectRemoving},
+	};
+}
+
+EASEntityHooks FASEntityHooks::Get(const UClass* InClass)
+{
+	check(IsInGameThread());
+	if (!InClass)
+		return EASEntityHooks::None;
+
+#if WITH_EDITOR
+	// Recompiled blueprints keep their class object, overrides may have changed
+	static FDelegateHandle reinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda(
+		[](const TMap<UObject*, UObject*>&)
+		{
+			Reset();
+		});
+#endif
+
+	if (const EASEntityHooks* hooks = ASEntityHooks::Cache.Find(InClass))
+	{
+		return *hooks;
+	}
+
+	const EASEntityHooks hooks = Compute(InClass);
+	ASEntityHooks::Cache.Add(InClass, hooks);
+	return hooks;
+}
+
+void FASEntityHooks::Reset()
+{
+	ASEntityHooks::Cache.Reset();
+}
+
+EASEntityHooks FASEntityHooks::Compute(const UClass* InClass)
+{
+	const UPackage* pluginPackage = UBasicAsEntity::StaticClass()->GetOutermost();
+
+	EASEntityHooks hooks = EASEntityHooks::None;
+	for (const UClass* current = InClass; current; current = current->GetSuperClass())
+	{
+		if (current->HasAnyClassFlags(CLASS_Native))
+		{
+			// Native overrides of _Implementation can not be detected, such classes declare them
+			if (current->GetOutermost() != pluginPackage)
+			{
+				if (const UBasicAsEntity* cdo = Cast<UBasicAsEntity>(current->GetDefaultObject()))
+				{
+					hooks |= cdo->GetNativeEntityHooks();
+				}
+				else
+				{
+					hooks |= EASEntityHooks::All;
+				}
+			}
+			break;
+		}
+
+		for (const ASEntityHooks::FHookFunction& function : ASEntityHooks::Functions)
+		{
+			if (current->FindFunctionByName(function.Name, EIncludeSuperFlag::ExcludeSuper))
+			{
+				hooks |= function.Hook;
+			}
+		}
+	}
+	return hooks;
+}
@@ -0,0 +1,181 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Objects/Abilities/Ability.h"
+
+#include "Components/ASComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Objects/Attribute.h"
+#include "Stats/ASReplicationStats.h"
+
+bool FASAbilityActivationRequest::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << AbilityIndex;
+	Ar << PredictionKey;
+	bOutSuccess = true;
+	return true;
+}
+
+UAbility::UAbility(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	Cooldown = 0.0f;
+	CooldownEndTime = 0.0;
+	CostAttributesVersion = 0;
+}
+
+void UAbility::OnRep_CooldownEndTime()
+{
+	OnCooldownUpdated();
+}
+
+void UAbility::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAbility, CooldownEndTime, Params);
+}
+
+FString UAbility::GetDebugString_Implementation() const
+{
+	return FString::Printf(TEXT("%s (Cooldown: %.2f/%.2f)"), *GetClass()->GetName(), GetCooldownRemaining(),
+	                       Cooldown);
+}
+
+void UAbility::SerializeSnapshot(FArchive& Ar)
+{
+	Super::SerializeSnapshot(Ar);
+
+	// Stored relative, server time of the restoring world is unrelated
+	float remaining = Ar.IsSaving() ? GetCooldownRemaining() : 0.0f;
+	Ar << remaining;
+
+	if (Ar.IsLoading())
+	{
+		StartCooldown(remaining);
+	}
+}
+
+void UAbility::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Costs.GetAllocatedSize() + CostAttributes.GetAllocatedSize());
+}
+
+const TArray<UAttribute*>& UAbility::GetCostAttributes() const
+{
+	const UASComponent* asComp = GetOwningComponent();
+	const uint32 version = asComp ? asComp->GetAttributeListVersion() : 0;
+	if (version != CostAttributesVersion)
+	{
+		// Attribute list has changed since the last check
+		CostAttributes.Reset(Costs.Num());
+		for (const FASAbilityCost& cost : Costs)
+		{
+			CostAttributes.Add(asComp && cost.Attribute ? asComp->Attribute(cost.Attribute) : nullptr);
+		}
+		CostAttributesVersion = version;
+	}
+	return CostAttributes;
+}
+
+bool UAbility::CanActivate() const
+{
+	return !IsOnCooldown() && CanPayCosts();
+}
+
+bool UAbility::CanPayCosts() const
+{
+	if (Costs.Num() == 0)
+		return true;
+
+	const TArray<UAttribute*>& attributes = GetCostAttributes();
+	const int32 n = Costs.Num();
+	for (int32 i = 0; i < n; ++i)
+	{
+		const UAttribute* attribute = attributes.IsValidIndex(i) ? attributes[i] : nullptr;
+		if (!IsValid(attribute) || attribute->GetCurrentValue() < Costs[i].Amount)
+			return false;
+	}
+	return true;
+}
+
+bool UAbility::IsOnCooldown() const
+{
+	return CooldownEndTime > 0.0 && GetServerWorldTime() < CooldownEndTime;
+}
+
+float UAbility::GetCooldownRemaining() const
+{
+	if (CooldownEndTime <= 0.0)
+		return 0.0f;
+	return FMath::Max(static_cast<float>(CooldownEndTime - GetServerWorldTime()), 0.0f);
+}
+
+float UAbility::GetCooldownProgress() const
+{
+	if (Cooldown <= 0.0f)
+		return 1.0f;
+	return FMath::Clamp(1.0f - GetCooldownRemaining() / Cooldown, 0.0f, 1.0f);
+}
+
+UASComponent* UAbility::GetOwningComponent() const
+{
+	return FindOwningComponent();
+}
+
+bool UAbility::TryActivate()
+{
+	if (!CanActivate())
+		return false;
+
+	CommitCosts();
+	StartCooldown();
+	Activate();
+	return true;
+}
+
+void UAbility::CommitCosts()
+{
+	const TArray<UAttribute*>& attributes = GetCostAttributes();
+	const int32 n = Costs.Num();
+	for (int32 i = 0; i < n; ++i)
+	{
+		UAttribute* attribute = attributes.IsValidIndex(i) ? attributes[i] : nullptr;
+		if (IsValid(attribute) && Costs[i].Amount != 0.0f)
+		{
+			attribute->SetValue(attribute->GetCurrentValue() - Costs[i].Amount);
+		}
+	}
+}
+
+void UAbility::StartCooldown(float InCooldown)
+{
+	const float length = InCooldown < 0.0f ? Cooldown : InCooldown;
+	CooldownEndTime = length > 0.0f ? GetServerWorldTime() + length : 0.0;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UAbility, CooldownEndTime, this);
+	AS_RECORD_PROPERTY_UPDATE(UAbility, CooldownEndTime, this);
+}
+
+void UAbility::ResetCooldown()
+{
+	if (CooldownEndTime == 0.0)
+		return;
+
+	CooldownEndTime = 0.0;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UAbility, CooldownEndTime, this);
+	AS_RECORD_PROPERTY_UPDATE(UAbility, CooldownEndTime, this);
+}
+
+void UAbility::Activate_Implementation()
+{
+}
+
+void UAbility::OnRemoved_Implementation()
+{
+}
+
+void UAbility::OnCooldownUpdated_Implementation()
+{
+}
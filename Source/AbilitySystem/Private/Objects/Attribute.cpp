@@ -3,9 +3,13 @@
 
 #include "Objects/Attribute.h"
 
+#include "AbilitySystem.h"
 #include "Components/ASComponent.h"
+#include "GameFramework/Actor.h"
+#include "Journal/ASJournalSubsystem.h"
 #include "Net/UnrealNetwork.h"
 #include "Net/Core/PushModel/PushModel.h"
+#include "Stats/ASReplicationStats.h"
 
 UAttribute::UAttribute(const FObjectInitializer& InObjectInitializer): Super(InObjectInitializer),
                                                                        MinValue(0), MaxValue(100), CurrentValue(50)
@@ -19,22 +23,35 @@ void UAttribute::ObjectBeginPlay()
 
 void UAttribute::OnRep_MinValue()
 {
-	OnMaxValueChanged.Broadcast(this, MinValue);
+	if (ShouldDeferRepNotify())
+		return;
+	BroadcastEvent(OnMinValueChanged, &FASAttributeNativeEvents::MinValueChanged, MinValue);
 }
 
 void UAttribute::OnRep_MaxValue()
 {
-	OnMaxValueChanged.Broadcast(this, MaxValue);
+	if (ShouldDeferRepNotify())
+		return;
+	BroadcastEvent(OnMaxValueChanged, &FASAttributeNativeEvents::MaxValueChanged, MaxValue);
 }
 
 void UAttribute::OnRep_CurrentValue()
 {
-	OnValueChanged.Broadcast(this, CurrentValue);
+	if (ShouldDeferRepNotify())
+		return;
+	BroadcastEvent(OnValueChanged, &FASAttributeNativeEvents::ValueChanged, CurrentValue);
+}
+
+void UAttribute::NotifyInitialState()
+{
+	BroadcastEvent(OnMinValueChanged, &FASAttributeNativeEvents::MinValueChanged, MinValue);
+	BroadcastEvent(OnMaxValueChanged, &FASAttributeNativeEvents::MaxValueChanged, MaxValue);
+	BroadcastEvent(OnValueChanged, &FASAttributeNativeEvents::ValueChanged, CurrentValue);
 }
 
 UASComponent* UAttribute::GetOwningComponent() const
 {
-	return GetOwner()->FindComponentByClass<UASComponent>();
+	return FindOwningComponent();
 }
 
 float UAttribute::GetValuePercent() const
@@ -77,6 +94,21 @@ void UAttribute::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifeti
 	DOREPLIFETIME_WITH_PARAMS_FAST(UAttribute, CurrentValue, Params);
 }
 
+void UAttribute::SerializeSnapshot(FArchive& Ar)
+{
+	Super::SerializeSnapshot(Ar);
+	Ar << MinValue;
+	Ar << MaxValue;
+	Ar << CurrentValue;
+
+	if (Ar.IsLoading())
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(UAttribute, MinValue, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UAttribute, MaxValue, this);
+		MARK_PROPERTY_DIRTY_FROM_NAME(UAttribute, CurrentValue, this);
+	}
+}
+
 FString UAttribute::GetDebugString_Implementation() const
 {
 	return FString::Printf(TEXT("Attribute"));
@@ -86,36 +118,85 @@ void UAttribute::OnWorkEnded_Implementation()
 {
 }
 
+void UAttribute::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(
+		OnMinValueChanged.GetAllocatedSize() + OnMaxValueChanged.GetAllocatedSize() +
+		OnValueChanged.GetAllocatedSize() + OnValueMinThresholdReached.GetAllocatedSize() +
+		OnValueMaxThresholdReached.GetAllocatedSize());
+
+	if (NativeEvents.IsValid())
+	{
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(sizeof(FASAttributeNativeEvents) +
+			NativeEvents->GetAllocatedSize());
+	}
+}
+
+FASAttributeNativeEvents& UAttribute::GetNativeEvents()
+{
+	if (!NativeEvents.IsValid())
+	{
+		NativeEvents = MakeUnique<FASAttributeNativeEvents>();
+	}
+	return *NativeEvents;
+}
+
 void UAttribute::SetMinValue(float InValue)
 {
 	MinValue = InValue;
 	MARK_PROPERTY_DIRTY_FROM_NAME(UAttribute, MinValue, this);
-	OnMinValueChanged.Broadcast(this, MinValue);
+	AS_RECORD_PROPERTY_UPDATE(UAttribute, MinValue, this);
+	BroadcastEvent(OnMinValueChanged, &FASAttributeNativeEvents::MinValueChanged, MinValue);
 }
 
 void UAttribute::SetMaxValue(float InValue)
 {
 	MaxValue = InValue;
 	MARK_PROPERTY_DIRTY_FROM_NAME(UAttribute, MaxValue, this);
-	OnMaxValueChanged.Broadcast(this, MaxValue);
+	AS_RECORD_PROPERTY_UPDATE(UAttribute, MaxValue, this);
+	BroadcastEvent(OnMaxValueChanged, &FASAttributeNativeEvents::MaxValueChanged, MaxValue);
 }
 
 void UAttribute::SetValue(float InValue)
 {
-	if (InValue < MinValue)
-	{
-		CurrentValue = MinValue;
-		OnValueMinThresholdReached.Broadcast(this, CurrentValue);
-	}
-	else if (InValue > MaxValue)
+	const bool bMinReached = InValue < MinValue;
+	const bool bMaxReached = !bMinReached && InValue > MaxValue;
+	CurrentValue = bMinReached ? MinValue : bMaxReached ? MaxValue : InValue;
+
+	MARK_PROPERTY_DIRTY_FROM_NAME(UAttribute, CurrentValue, this);
+	AS_RECORD_PROPERTY_UPDATE(UAttribute, CurrentValue, this);
+	AS_JOURNAL_RECORD(GetTypedOuter<AActor>(), AttributeValue, GetClass(), CurrentValue);
+
+	if (!CanNotifyValueChange())
+		return;
+
+	++ValueNotifyDepth;
+	if (bMinReached)
 	{
-		CurrentValue = MaxValue;
-		OnValueMaxThresholdReached.Broadcast(this, CurrentValue);
+		BroadcastEvent(OnValueMinThresholdReached, &FASAttributeNativeEvents::ValueMinThresholdReached, CurrentValue);
 	}
-	else
+	else if (bMaxReached)
 	{
-		CurrentValue = InValue;
+		BroadcastEvent(OnValueMaxThresholdReached, &FASAttributeNativeEvents::ValueMaxThresholdReached, CurrentValue);
 	}
-	MARK_PROPERTY_DIRTY_FROM_NAME(UAttribute, CurrentValue, this);
-	OnValueChanged.Broadcast(this, CurrentValue);
+	BroadcastEvent(OnValueChanged, &FASAttributeNativeEvents::ValueChanged, CurrentValue);
+	--ValueNotifyDepth;
+}
+
+bool UAttribute::CanNotifyValueChange() const
+{
+	if (ValueNotifyDepth == 0)
+		return true;
+
+	// Only nested sets from value listeners get here
+	const UASComponent* asComp = FindOwningComponent();
+	const int32 maxDepth = asComp ? asComp->GetMaxCascadeDepth() : 8;
+	if (ValueNotifyDepth < maxDepth)
+		return true;
+
+	UE_LOG(LogAbilitySystem, Warning,
+	       TEXT("%s: value set %d levels deep from value listeners, listeners are not notified (MaxCascadeDepth)"),
+	       *GetPathName(), ValueNotifyDepth);
+	return false;
 }
@@ -3,10 +3,116 @@
 
 #include "Objects/BasicAsEntity.h"
 
+#include "Components/ASComponent.h"
+#include "Engine/ActorChannel.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/DataBunch.h"
+#include "Stats/ASMemoryStats.h"
+#include "Stats/ASReplicationStats.h"
+
+#if UE_WITH_IRIS
+#include "Iris/ReplicationSystem/ReplicationFragmentUtil.h"
+#endif
+
 UBasicAsEntity::UBasicAsEntity(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 }
 
+bool UBasicAsEntity::ReplicateAsSubobject(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags)
+{
+	if (!PassesNetCondition(GetNetCondition(), *RepFlags))
+		return false;
+
+	if (!FASReplicationStats::IsEnabled())
+	{
+		bool bWrote = Channel->ReplicateSubobject(this, *Bunch, *RepFlags);
+		bWrote |= ReplicateSubobjects(Channel, Bunch, RepFlags);
+		return bWrote;
+	}
+
+	const int64 bitsBefore = Bunch->GetNumBits();
+	bool bWrote = Channel->ReplicateSubobject(this, *Bunch, *RepFlags);
+	bWrote |= ReplicateSubobjects(Channel, Bunch, RepFlags);
+	FASReplicationStats::Get().RecordReplication(GetClass(), Bunch->GetNumBits() - bitsBefore, bWrote);
+	return bWrote;
+}
+
+#if UE_WITH_IRIS
+void UBasicAsEntity::RegisterReplicationFragments(UE::Net::FFragmentRegistrationContext& Context,
+                                                  UE::Net::EFragmentRegistrationFlags RegistrationFlags)
+{
+	// Descriptors are built once per class and shared, serialization runs on the Iris worker threads
+	UE::Net::FReplicationFragmentUtil::CreateAndRegisterFragmentsForObject(this, Context, RegistrationFlags);
+}
+#endif
+
+bool UBasicAsEntity::PassesNetCondition(ELifetimeCondition InCondition, const FReplicationFlags& InRepFlags)
+{
+	switch (InCondition)
+	{
+	case COND_OwnerOnly:
+		return InRepFlags.bNetOwner;
+	case COND_SkipOwner:
+		return !InRepFlags.bNetOwner;
+	case COND_SimulatedOnly:
+		return InRepFlags.bNetSimulated;
+	case COND_AutonomousOnly:
+		return !InRepFlags.bNetSimulated;
+	case COND_ReplayOnly:
+		return InRepFlags.bReplay;
+	case COND_SkipReplay:
+		return !InRepFlags.bReplay;
+	case COND_Never:
+		return false;
+	default:
+		return true;
+	}
+}
+
+void UBasicAsEntity::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	if (CumulativeResourceSize.GetResourceSizeMode() == EResourceSizeMode::EstimatedTotal)
+	{
+		// Replication keeps a shadow copy of replicated properties
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(FASMemoryStats::GetReplicatedStateSize(GetClass()));
+	}
+}
+
+UASComponent* UBasicAsEntity::FindOwningComponent() const
+{
+	UASComponent* asComp = CachedOwningComponent.Get();
+	if (!asComp)
+	{
+		if (const AActor* owner = GetOwner())
+		{
+			asComp = owner->FindComponentByClass<UASComponent>();
+			CachedOwningComponent = asComp;
+		}
+	}
+	return asComp;
+}
+
+bool UBasicAsEntity::ShouldDeferRepNotify() const
+{
+	UASComponent* asComp = FindOwningComponent();
+	return asComp && asComp->DeferInitialRepNotify();
+}
+
+double UBasicAsEntity::GetServerWorldTime() const
+{
+	const UWorld* world = GetWorld();
+	if (!world)
+		return 0.0;
+
+	const AGameStateBase* gameState = world->GetGameState();
+	return gameState ? gameState->GetServerWorldTimeSeconds() : world->GetTimeSeconds();
+}
+
+void UBasicAsEntity::SerializeSnapshot(FArchive& Ar)
+{
+}
+
 FString UBasicAsEntity::GetDebugString_Implementation() const
 {
 	return FString::Printf(TEXT("As Entity"));
@@ -3,6 +3,10 @@
 
 #include "Objects/Effects/DurationEffect.h"
 
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Stats/ASReplicationStats.h"
+
 UDurationEffect::UDurationEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	Time = 10.0f;
@@ -10,10 +14,74 @@ UDurationEffect::UDurationEffect(const FObjectInitializer& ObjectInitializer) :
 
 void UDurationEffect::RunTimer()
 {
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle, FTimerDelegate::CreateLambda([this]()
+	StartDurationTimer(Time);
+}
+
+void UDurationEffect::StartDurationTimer(float InTime)
+{
+	SetEffectTimer(TimerHandle, ScheduledTimerHandle, FTimerDelegate::CreateLambda([this]()
 	{
 		EndWork();
-	}), FMath::IsNearlyZero(Time) ? 0.1f : Time, false);
+	}), InTime, false);
+
+	StartTiming(Timing, InTime);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UDurationEffect, Timing, this);
+	AS_RECORD_PROPERTY_UPDATE(UDurationEffect, Timing, this);
+	OnTimingUpdated();
+}
+
+void UDurationEffect::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UDurationEffect, Timing, Params);
+}
+
+void UDurationEffect::OnRep_Timing()
+{
+	OnTimingUpdated();
+}
+
+void UDurationEffect::OnTimingUpdated_Implementation()
+{
+}
+
+float UDurationEffect::GetRemainingTime() const
+{
+	// Server knows the exact timer, clients compute it from the replicated timing
+	if (GetOwner()->HasAuthority())
+	{
+		return FMath::Max(GetEffectTimerRemaining(TimerHandle, ScheduledTimerHandle), 0.0f);
+	}
+	return Timing.GetRemaining(GetEffectTime());
+}
+
+float UDurationEffect::GetDurationProgress() const
+{
+	if (!Timing.IsSet())
+		return 0.0f;
+	return FMath::Clamp(1.0f - GetRemainingTime() / Timing.Duration, 0.0f, 1.0f);
+}
+
+void UDurationEffect::ResumeWork()
+{
+	Super::ResumeWork();
+	StartDurationTimer(RestoredRemainingTime > 0.0f ? RestoredRemainingTime : Time);
+	RestoredRemainingTime = -1.0f;
+}
+
+void UDurationEffect::SerializeSnapshot(FArchive& Ar)
+{
+	Super::SerializeSnapshot(Ar);
+
+	float remaining = Ar.IsSaving() ? GetRemainingTime() : 0.0f;
+	Ar << remaining;
+
+	if (Ar.IsLoading())
+	{
+		RestoredRemainingTime = remaining;
+	}
 }
 
 FString UDurationEffect::GetDebugString_Implementation() const
@@ -23,6 +91,7 @@ FString UDurationEffect::GetDebugString_Implementation() const
 
 void UDurationEffect::StartWork_Implementation()
 {
+	Super::StartWork_Implementation();
 	RunTimer();
 }
 
@@ -38,7 +107,5 @@ bool UDurationEffect::Stack_Implementation(UEffect* AnotherEffect)
 
 void UDurationEffect::OnWorkEnded_Implementation()
 {
-	FTimerManager& manager = GetWorld()->GetTimerManager();
-	if (manager.IsTimerActive(TimerHandle))
-		manager.ClearTimer(TimerHandle);
+	ClearEffectTimer(TimerHandle, ScheduledTimerHandle);
 }
@@ -6,15 +6,83 @@
 #include "Components/ASComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "Net/Core/PushModel/PushModel.h"
+#include "Objects/Attribute.h"
+#include "Serialization/ASSnapshot.h"
+#include "Stats/ASReplicationStats.h"
+#include "Subsystems/ASParallelTickSubsystem.h"
+
+float FASEffectTiming::GetRemaining(double InServerTime) const
+{
+	if (!IsSet())
+		return 0.0f;
+	return FMath::Max(static_cast<float>(StartTime + Duration - InServerTime), 0.0f);
+}
+
+float FASEffectTiming::GetRemainingLooping(double InServerTime) const
+{
+	if (!IsSet())
+		return 0.0f;
+	const double elapsed = InServerTime - StartTime;
+	if (elapsed < 0.0)
+		return static_cast<float>(-elapsed);
+	return static_cast<float>(Duration - FMath::Fmod(elapsed, static_cast<double>(Duration)));
+}
 
 UEffect::UEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	bStackable = false;
 	StackableNum = 1;
+	bParallelPeriodTick = false;
+	Level = 1;
+	bApplyMagnitudeOnStart = false;
+	MagnitudeAttributesVersion = 0;
+}
+
+void UEffect::PostInitProperties()
+{
+	Super::PostInitProperties();
+	// Instances share the program compiled for class defaults
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		Magnitude.EnsureCompiled(this);
+	}
+}
+
+void UEffect::PostLoad()
+{
+	Super::PostLoad();
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		Magnitude.Compile(this);
+	}
 }
 
+void UEffect::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(MagnitudeAttributes.GetAllocatedSize());
+}
+
+#if WITH_EDITOR
+void UEffect::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UEffect, Magnitude))
+	{
+		Magnitude.Compile(this);
+	}
+}
+#endif
+
 void UEffect::OnRep_StackableNum()
 {
+	if (ShouldDeferRepNotify())
+		return;
+
+	if (UASComponent* asComp = GetOwningComponent())
+	{
+		asComp->NotifyEffectStackChanged(this);
+	}
 }
 
 void UEffect::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -23,6 +91,8 @@ void UEffect::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeP
 	FDoRepLifetimeParams Params;
 	Params.bIsPushBased = true;
 	DOREPLIFETIME_WITH_PARAMS_FAST(UEffect, StackableNum, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UEffect, Level, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(UEffect, Context, Params);
 }
 
 void UEffect::ObjectBeginPlay()
@@ -42,16 +112,202 @@ void UEffect::EndWork()
 	}
 }
 
+bool UEffect::QueueParallelPeriodTick()
+{
+	if (!bParallelPeriodTick)
+		return false;
+
+	// Scheduled effects must see the result of every tick within the same step
+	const UASComponent* asComp = GetOwningComponent();
+	if (asComp && asComp->UsesEffectScheduler())
+		return false;
+
+	UASParallelTickSubsystem* subsystem = GetWorld()->GetSubsystem<UASParallelTickSubsystem>();
+	if (!subsystem)
+		return false;
+
+	// Worker threads must not resolve anything
+	PrepareMagnitude();
+	subsystem->QueuePeriodTick(this);
+	return true;
+}
+
+void UEffect::FlushQueuedPeriodTick()
+{
+	if (!bParallelPeriodTick)
+		return;
+
+	if (UASParallelTickSubsystem* subsystem = GetWorld()->GetSubsystem<UASParallelTickSubsystem>())
+	{
+		subsystem->FlushIfQueued(this);
+	}
+}
+
+void UEffect::EvaluatePeriodTick(FASAttributeWriteBuffer& OutWrites) const
+{
+	UAttribute* target = MagnitudeAttributes.Num() > 0 ? MagnitudeAttributes.Last() : nullptr;
+	if (IsValid(target) && Magnitude.IsCompiled())
+	{
+		OutWrites.Add(target, EvaluatePreparedMagnitude());
+	}
+}
+
+void UEffect::PrepareMagnitude()
+{
+	if (!Magnitude.EnsureCompiled(this))
+		return;
+
+	const UASComponent* asComp = GetOwningComponent();
+	const uint32 version = asComp ? asComp->GetAttributeListVersion() : 0;
+	if (version == MagnitudeAttributesVersion && MagnitudeAttributes.Num() > 0)
+		return;
+
+	MagnitudeAttributes.Reset(Magnitude.Attributes.Num() + 1);
+	for (const FASFormulaAttribute& attribute : Magnitude.Attributes)
+	{
+		MagnitudeAttributes.Add(asComp && attribute.Attribute ? asComp->Attribute(attribute.Attribute) : nullptr);
+	}
+	MagnitudeAttributes.Add(asComp && MagnitudeTarget ? asComp->Attribute(MagnitudeTarget) : nullptr);
+	MagnitudeAttributesVersion = version;
+}
+
+float UEffect::EvaluatePreparedMagnitude() const
+{
+	FASFormulaContext context;
+	// Target is not part of the formula
+	context.Attributes = MakeArrayView(MagnitudeAttributes.GetData(), FMath::Max(MagnitudeAttributes.Num() - 1, 0));
+	context.Stacks = static_cast<float>(StackableNum);
+	context.Level = static_cast<float>(Level);
+	return Magnitude.Evaluate(context);
+}
+
+float UEffect::EvaluateMagnitude()
+{
+	PrepareMagnitude();
+	return EvaluatePreparedMagnitude();
+}
+
+void UEffect::ApplyMagnitude()
+{
+	if (!MagnitudeTarget)
+		return;
+
+	PrepareMagnitude();
+	UAttribute* target = MagnitudeAttributes.Num() > 0 ? MagnitudeAttributes.Last() : nullptr;
+	if (IsValid(target) && Magnitude.IsCompiled())
+	{
+		target->SetValue(target->GetCurrentValue() + EvaluatePreparedMagnitude());
+	}
+}
+
+void UEffect::StartTiming(FASEffectTiming& OutTiming, float InLength, float InFirstDelay) const
+{
+	// Expressed as if the timer had started a full length before its first callback
+	const float firstDelay = InFirstDelay >= 0.0f ? InFirstDelay : InLength;
+	OutTiming.Duration = InLength;
+	OutTiming.StartTime = GetEffectTime() + firstDelay - InLength;
+}
+
+double UEffect::GetEffectTime() const
+{
+	const UASComponent* asComp = GetOwningComponent();
+	return asComp ? asComp->GetEffectTime() : GetServerWorldTime();
+}
+
+float UEffect::GetEffectTimeRate() const
+{
+	const UASComponent* asComp = GetOwningComponent();
+	return asComp ? asComp->GetEffectTimeRate() : 1.0f;
+}
+
+void UEffect::SetEffectTimer(FTimerHandle& InOutWorldHandle, FASEffectTimerHandle& InOutScheduledHandle,
+                             const FTimerDelegate& InDelegate, float InRate, bool bInLoop, float InFirstDelay)
+{
+	const float rate = FMath::IsNearlyZero(InRate) ? 0.1f : InRate;
+	UASComponent* asComp = GetOwningComponent();
+	if (asComp && asComp->UsesEffectScheduler())
+	{
+		asComp->GetEffectScheduler().SetTimer(InOutScheduledHandle, InDelegate, rate, bInLoop, InFirstDelay);
+	}
+	else
+	{
+		GetWorld()->GetTimerManager().SetTimer(InOutWorldHandle, InDelegate, rate, bInLoop, InFirstDelay);
+	}
+}
+
+void UEffect::ClearEffectTimer(FTimerHandle& InOutWorldHandle, FASEffectTimerHandle& InOutScheduledHandle)
+{
+	if (InOutScheduledHandle.IsValid())
+	{
+		if (UASComponent* asComp = GetOwningComponent())
+		{
+			asComp->GetEffectScheduler().ClearTimer(InOutScheduledHandle);
+		}
+		InOutScheduledHandle.Invalidate();
+	}
+
+	FTimerManager& manager = GetWorld()->GetTimerManager();
+	if (manager.IsTimerActive(InOutWorldHandle))
+		manager.ClearTimer(InOutWorldHandle);
+}
+
+float UEffect::GetEffectTimerRemaining(const FTimerHandle& InWorldHandle,
+                                       const FASEffectTimerHandle& InScheduledHandle) const
+{
+	if (InScheduledHandle.IsValid())
+	{
+		const UASComponent* asComp = GetOwningComponent();
+		return asComp ? asComp->GetEffectScheduler().GetTimerRemaining(InScheduledHandle) : -1.0f;
+	}
+	return GetWorld()->GetTimerManager().GetTimerRemaining(InWorldHandle);
+}
+
 void UEffect::SetStackableNum(int32 InValue)
 {
 	StackableNum = FMath::Clamp(InValue, 1, TNumericLimits<int32>::Max());
 	MARK_PROPERTY_DIRTY_FROM_NAME(UEffect, StackableNum, this);
+	AS_RECORD_PROPERTY_UPDATE(UEffect, StackableNum, this);
+
+	if (UASComponent* asComp = GetOwningComponent())
+	{
+		asComp->NotifyEffectStackChanged(this);
+	}
+}
+
+void UEffect::SetLevel(int32 InValue)
+{
+	Level = InValue;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UEffect, Level, this);
+	AS_RECORD_PROPERTY_UPDATE(UEffect, Level, this);
+}
+
+void UEffect::SetContext(const FASEffectContext& InContext)
+{
+	Context = InContext;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UEffect, Context, this);
+	AS_RECORD_PROPERTY_UPDATE(UEffect, Context, this);
+}
+
+
+void UEffect::ResumeWork()
+{
+	// Nothing to restart
+}
+
+void UEffect::OnEffectClockChanged()
+{
 }
 
+void UEffect::OnRemovedOnClient()
+{
+}
 
 void UEffect::StartWork_Implementation()
 {
-	// Some work here
+	if (bApplyMagnitudeOnStart)
+	{
+		ApplyMagnitude();
+	}
 }
 
 void UEffect::OnWorkEnded_Implementation()
@@ -94,7 +350,24 @@ void UEffect::OnEffectAdded_Implementation(UEffect* AnotherEffect)
 
 UASComponent* UEffect::GetOwningComponent() const
 {
-	return GetOwner()->FindComponentByClass<UASComponent>();
+	return FindOwningComponent();
+}
+
+void UEffect::SerializeSnapshot(FArchive& Ar)
+{
+	Super::SerializeSnapshot(Ar);
+	Ar << StackableNum;
+
+	if (ASSnapshot::GetVersion(Ar) >= EASSnapshotVersion::EffectLevel)
+	{
+		Ar << Level;
+	}
+
+	if (Ar.IsLoading())
+	{
+		SetStackableNum(StackableNum);
+		SetLevel(Level);
+	}
 }
 
 FString UEffect::GetDebugString_Implementation() const
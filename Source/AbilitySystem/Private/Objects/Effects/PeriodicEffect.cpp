@@ -3,24 +3,151 @@
 
 #include "Objects/Effects/PeriodicEffect.h"
 
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Stats/ASReplicationStats.h"
+
 UPeriodicEffect::UPeriodicEffect(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer), Period(1.0f)
 {
+	bSimulateCosmeticTicks = false;
 }
 
 void UPeriodicEffect::RunPeriodicTimer()
 {
-	FTimerManager& manager = GetWorld()->GetTimerManager();
-	if (manager.IsTimerActive(PeriodicTimerHandle))
-		manager.ClearTimer(PeriodicTimerHandle);
-	manager.SetTimer(PeriodicTimerHandle, FTimerDelegate::CreateUObject(this, &UPeriodicEffect::PeriodTick),
-	                 FMath::IsNearlyZero(Period) ? 0.1f : Period, true);
+	StartPeriodicTimer(-1.0f);
+}
+
+void UPeriodicEffect::StartPeriodicTimer(float InFirstDelay)
+{
+	ClearPeriodicTimer();
+	SetEffectTimer(PeriodicTimerHandle, ScheduledPeriodicTimerHandle,
+	               FTimerDelegate::CreateUObject(this, &UPeriodicEffect::HandlePeriodicTimer), Period, true, InFirstDelay);
+
+	StartTiming(PeriodTiming, Period, InFirstDelay);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UPeriodicEffect, PeriodTiming, this);
+	AS_RECORD_PROPERTY_UPDATE(UPeriodicEffect, PeriodTiming, this);
+	OnPeriodTimingUpdated();
+}
+
+void UPeriodicEffect::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UPeriodicEffect, PeriodTiming, Params);
+}
+
+void UPeriodicEffect::OnRep_PeriodTiming()
+{
+	OnPeriodTimingUpdated();
+
+	if (bSimulateCosmeticTicks)
+	{
+		RunCosmeticTimer();
+	}
+}
+
+void UPeriodicEffect::RunCosmeticTimer()
+{
+	if (!PeriodTiming.IsSet())
+		return;
+
+	// Local timer runs in world time, scaled effects tick at a different real rate
+	const float rate = GetEffectTimeRate();
+	if (rate <= 0.0f)
+	{
+		ClearCosmeticTimer();
+		return;
+	}
+
+	GetWorld()->GetTimerManager().SetTimer(CosmeticTimerHandle,
+	                                       FTimerDelegate::CreateUObject(this, &UPeriodicEffect::HandleCosmeticTimer),
+	                                       PeriodTiming.Duration / rate, true,
+	                                       PeriodTiming.GetRemainingLooping(GetEffectTime()) / rate);
+}
+
+void UPeriodicEffect::OnEffectClockChanged()
+{
+	Super::OnEffectClockChanged();
+	if (bSimulateCosmeticTicks)
+	{
+		RunCosmeticTimer();
+	}
+}
+
+void UPeriodicEffect::ClearCosmeticTimer()
+{
+	if (UWorld* world = GetWorld())
+	{
+		world->GetTimerManager().ClearTimer(CosmeticTimerHandle);
+	}
+}
+
+void UPeriodicEffect::HandleCosmeticTimer()
+{
+	// Duration is over, the removal has not been replicated yet
+	if (Timing.IsSet() && Timing.GetRemaining(GetEffectTime()) <= 0.0f)
+	{
+		ClearCosmeticTimer();
+		return;
+	}
+	CosmeticPeriodTick();
+}
+
+void UPeriodicEffect::OnRemovedOnClient()
+{
+	Super::OnRemovedOnClient();
+	ClearCosmeticTimer();
+}
+
+void UPeriodicEffect::CosmeticPeriodTick_Implementation()
+{
+}
+
+void UPeriodicEffect::OnPeriodTimingUpdated_Implementation()
+{
+}
+
+float UPeriodicEffect::GetTimeUntilNextTick() const
+{
+	// Server knows the exact timer, clients compute it from the replicated phase
+	if (GetOwner()->HasAuthority())
+	{
+		return FMath::Max(GetEffectTimerRemaining(PeriodicTimerHandle, ScheduledPeriodicTimerHandle), 0.0f);
+	}
+	return PeriodTiming.GetRemainingLooping(GetEffectTime());
+}
+
+float UPeriodicEffect::GetTickProgress() const
+{
+	if (!PeriodTiming.IsSet())
+		return 0.0f;
+	return FMath::Clamp(1.0f - GetTimeUntilNextTick() / PeriodTiming.Duration, 0.0f, 1.0f);
+}
+
+void UPeriodicEffect::ResumeWork()
+{
+	Super::ResumeWork();
+	StartPeriodicTimer(RestoredTimeUntilTick);
+	RestoredTimeUntilTick = -1.0f;
+}
+
+void UPeriodicEffect::SerializeSnapshot(FArchive& Ar)
+{
+	Super::SerializeSnapshot(Ar);
+
+	float untilTick = Ar.IsSaving() ? GetTimeUntilNextTick() : 0.0f;
+	Ar << untilTick;
+
+	if (Ar.IsLoading())
+	{
+		RestoredTimeUntilTick = untilTick;
+	}
 }
 
 void UPeriodicEffect::ClearPeriodicTimer()
 {
-	FTimerManager& manager = GetWorld()->GetTimerManager();
-	if (manager.IsTimerActive(PeriodicTimerHandle))
-		manager.ClearTimer(PeriodicTimerHandle);
+	ClearEffectTimer(PeriodicTimerHandle, ScheduledPeriodicTimerHandle);
 }
 
 void UPeriodicEffect::StartWork_Implementation()
@@ -35,9 +162,22 @@ void UPeriodicEffect::OnWorkEnded_Implementation()
 	ClearPeriodicTimer();
 }
 
+void UPeriodicEffect::HandlePeriodicTimer()
+{
+	if (!QueueParallelPeriodTick())
+	{
+		PeriodTick();
+	}
+
+	if (bSimulateCosmeticTicks && GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		CosmeticPeriodTick();
+	}
+}
+
 void UPeriodicEffect::PeriodTick_Implementation()
 {
-	// Tick
+	ApplyMagnitude();
 }
 
 FString UPeriodicEffect::GetDebugString_Implementation() const
@@ -3,25 +3,146 @@
 
 #include "Objects/Effects/PeriodicInstantEffect.h"
 
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Stats/ASReplicationStats.h"
+
 UPeriodicInstantEffect::UPeriodicInstantEffect(const FObjectInitializer& ObjectInitializer): Super(ObjectInitializer),
 	Period(1.0f)
 {
+	bSimulateCosmeticTicks = false;
 }
 
 void UPeriodicInstantEffect::RunPeriodicTimer()
 {
-	FTimerManager& manager = GetWorld()->GetTimerManager();
-	if (manager.IsTimerActive(PeriodicTimerHandle))
-		manager.ClearTimer(PeriodicTimerHandle);
-	manager.SetTimer(PeriodicTimerHandle, FTimerDelegate::CreateUObject(this, &UPeriodicInstantEffect::PeriodTick),
-	                 FMath::IsNearlyZero(Period) ? 0.1f : Period, true);
+	StartPeriodicTimer(-1.0f);
+}
+
+void UPeriodicInstantEffect::StartPeriodicTimer(float InFirstDelay)
+{
+	ClearPeriodicTimer();
+	SetEffectTimer(PeriodicTimerHandle, ScheduledPeriodicTimerHandle,
+	               FTimerDelegate::CreateUObject(this, &UPeriodicInstantEffect::HandlePeriodicTimer), Period, true, InFirstDelay);
+
+	StartTiming(PeriodTiming, Period, InFirstDelay);
+	MARK_PROPERTY_DIRTY_FROM_NAME(UPeriodicInstantEffect, PeriodTiming, this);
+	AS_RECORD_PROPERTY_UPDATE(UPeriodicInstantEffect, PeriodTiming, this);
+	OnPeriodTimingUpdated();
+}
+
+void UPeriodicInstantEffect::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UPeriodicInstantEffect, PeriodTiming, Params);
+}
+
+void UPeriodicInstantEffect::OnRep_PeriodTiming()
+{
+	OnPeriodTimingUpdated();
+
+	if (bSimulateCosmeticTicks)
+	{
+		RunCosmeticTimer();
+	}
+}
+
+void UPeriodicInstantEffect::RunCosmeticTimer()
+{
+	if (!PeriodTiming.IsSet())
+		return;
+
+	// Local timer runs in world time, scaled effects tick at a different real rate
+	const float rate = GetEffectTimeRate();
+	if (rate <= 0.0f)
+	{
+		ClearCosmeticTimer();
+		return;
+	}
+
+	GetWorld()->GetTimerManager().SetTimer(CosmeticTimerHandle,
+	                                       FTimerDelegate::CreateUObject(this, &UPeriodicInstantEffect::HandleCosmeticTimer),
+	                                       PeriodTiming.Duration / rate, true,
+	                                       PeriodTiming.GetRemainingLooping(GetEffectTime()) / rate);
+}
+
+void UPeriodicInstantEffect::OnEffectClockChanged()
+{
+	Super::OnEffectClockChanged();
+	if (bSimulateCosmeticTicks)
+	{
+		RunCosmeticTimer();
+	}
+}
+
+void UPeriodicInstantEffect::ClearCosmeticTimer()
+{
+	if (UWorld* world = GetWorld())
+	{
+		world->GetTimerManager().ClearTimer(CosmeticTimerHandle);
+	}
+}
+
+void UPeriodicInstantEffect::HandleCosmeticTimer()
+{
+	CosmeticPeriodTick();
+}
+
+void UPeriodicInstantEffect::OnRemovedOnClient()
+{
+	Super::OnRemovedOnClient();
+	ClearCosmeticTimer();
+}
+
+void UPeriodicInstantEffect::CosmeticPeriodTick_Implementation()
+{
+}
+
+void UPeriodicInstantEffect::OnPeriodTimingUpdated_Implementation()
+{
+}
+
+float UPeriodicInstantEffect::GetTimeUntilNextTick() const
+{
+	// Server knows the exact timer, clients compute it from the replicated phase
+	if (GetOwner()->HasAuthority())
+	{
+		return FMath::Max(GetEffectTimerRemaining(PeriodicTimerHandle, ScheduledPeriodicTimerHandle), 0.0f);
+	}
+	return PeriodTiming.GetRemainingLooping(GetEffectTime());
+}
+
+float UPeriodicInstantEffect::GetTickProgress() const
+{
+	if (!PeriodTiming.IsSet())
+		return 0.0f;
+	return FMath::Clamp(1.0f - GetTimeUntilNextTick() / PeriodTiming.Duration, 0.0f, 1.0f);
+}
+
+void UPeriodicInstantEffect::ResumeWork()
+{
+	Super::ResumeWork();
+	StartPeriodicTimer(RestoredTimeUntilTick);
+	RestoredTimeUntilTick = -1.0f;
+}
+
+void UPeriodicInstantEffect::SerializeSnapshot(FArchive& Ar)
+{
+	Super::SerializeSnapshot(Ar);
+
+	float untilTick = Ar.IsSaving() ? GetTimeUntilNextTick() : 0.0f;
+	Ar << untilTick;
+
+	if (Ar.IsLoading())
+	{
+		RestoredTimeUntilTick = untilTick;
+	}
 }
 
 void UPeriodicInstantEffect::ClearPeriodicTimer()
 {
-	FTimerManager& manager = GetWorld()->GetTimerManager();
-	if (manager.IsTimerActive(PeriodicTimerHandle))
-		manager.ClearTimer(PeriodicTimerHandle);
+	ClearEffectTimer(PeriodicTimerHandle, ScheduledPeriodicTimerHandle);
 }
 
 void UPeriodicInstantEffect::StartWork_Implementation()
@@ -30,6 +151,13 @@ void UPeriodicInstantEffect::StartWork_Implementation()
 	RunPeriodicTimer();
 }
 
+void UPeriodicInstantEffect::OnWorkEnded_Implementation()
+{
+	Super::OnWorkEnded_Implementation();
+	// Effect can be removed by the component without EndWork
+	ClearPeriodicTimer();
+}
+
 FString UPeriodicInstantEffect::GetDebugString_Implementation() const
 {
 	return FString(TEXT("PeriodicInstantEffect"));
@@ -41,6 +169,20 @@ void UPeriodicInstantEffect::EndWork()
 	Super::EndWork();
 }
 
+void UPeriodicInstantEffect::HandlePeriodicTimer()
+{
+	if (!QueueParallelPeriodTick())
+	{
+		PeriodTick();
+	}
+
+	if (bSimulateCosmeticTicks && GetWorld()->GetNetMode() != NM_DedicatedServer)
+	{
+		CosmeticPeriodTick();
+	}
+}
+
 void UPeriodicInstantEffect::PeriodTick_Implementation()
 {
+	ApplyMagnitude();
 }
@@ -0,0 +1,105 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Serialization/ASSnapshot.h"
+
+#include "UObject/SoftObjectPath.h"
+
+uint32 FASSnapshotClassTable::FindOrAdd(UClass* InClass)
+{
+	if (const uint32* index = Indices.Find(InClass))
+	{
+		return *index;
+	}
+
+	const uint32 index = Classes.Add(InClass);
+	Indices.Add(InClass, index);
+	return index;
+}
+
+UClass* FASSnapshotClassTable::Get(uint32 InIndex) const
+{
+	return Classes.IsValidIndex(InIndex) ? Classes[InIndex] : nullptr;
+}
+
+void FASSnapshotClassTable::Serialize(FArchive& Ar)
+{
+	uint32 num = Classes.Num();
+	Ar.SerializeIntPacked(num);
+
+	if (Ar.IsLoading())
+	{
+		if (num > ASSnapshot::MaxEntries)
+		{
+			Ar.SetError();
+			return;
+		}
+
+		Classes.Reset(num);
+		Indices.Reset();
+	}
+
+	for (uint32 i = 0; i < num && !Ar.IsError(); ++i)
+	{
+		FSoftClassPath path;
+		if (Ar.IsSaving())
+		{
+			path = FSoftClassPath(Classes[i]);
+		}
+
+		FString pathString = path.ToString();
+		Ar << pathString;
+
+		if (Ar.IsLoading())
+		{
+			// Unknown and unloaded classes stay null, their entries are skipped
+			UClass* loaded = FSoftClassPath(pathString).ResolveClass();
+			Classes.Add(loaded);
+			if (loaded)
+			{
+				Indices.Add(loaded, i);
+			}
+		}
+	}
+}
+
+namespace ASSnapshot
+{
+	const FGuid VersionGuid(0x3A1F7C42, 0x9B0E4D17, 0xA5C83E61, 0x2D94B0F8);
+
+	void SetVersion(FArchive& Ar, EASSnapshotVersion InVersion)
+	{
+		Ar.SetCustomVersion(VersionGuid, static_cast<int32>(InVersion), TEXT("ASSnapshot"));
+	}
+
+	EASSnapshotVersion GetVersion(const FArchive& Ar)
+	{
+		return static_cast<EASSnapshotVersion>(Ar.CustomVer(VersionGuid));
+	}
+
+	void WriteHeader(FArchive& Ar)
+	{
+		uint32 magic = Magic;
+		uint16 version = static_cast<uint16>(EASSnapshotVersion::Latest);
+		Ar << magic;
+		Ar << version;
+	}
+
+	bool ReadHeader(FArchive& Ar, EASSnapshotVersion& OutVersion)
+	{
+		uint32 magic = 0;
+		uint16 version = 0;
+		Ar << magic;
+		Ar << version;
+
+		if (Ar.IsError() || magic != Magic)
+			return false;
+
+		if (version < static_cast<uint16>(EASSnapshotVersion::Initial) ||
+			version > static_cast<uint16>(EASSnapshotVersion::Latest))
+			return false;
+
+		OutVersion = static_cast<EASSnapshotVersion>(version);
+		return true;
+	}
+}
@@ -0,0 +1,100 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Stats/ASMemoryStats.h"
+
+#include "Components/ASComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectIterator.h"
+
+namespace ASMemoryStats
+{
+	static FAutoConsoleCommandWithOutputDevice CmdReport(
+		TEXT("as.Memory.Report"),
+		TEXT("Prints estimated memory of ability system components per actor and per world"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			FASMemoryStats::Report(Ar);
+		}));
+}
+
+SIZE_T FASMemoryStats::GetReplicatedStateSize(const UClass* InClass)
+{
+	static TMap<FObjectKey, SIZE_T> cache;
+	if (const SIZE_T* size = cache.Find(InClass))
+	{
+		return *size;
+	}
+
+	SIZE_T size = 0;
+	for (TFieldIterator<FProperty> it(InClass); it; ++it)
+	{
+		if (it->HasAnyPropertyFlags(CPF_Net))
+		{
+			size += it->GetSize();
+		}
+	}
+	cache.Add(InClass, size);
+	return size;
+}
+
+void FASMemoryStats::Report(FOutputDevice& Ar)
+{
+	struct FWorldTotals
+	{
+		FString Name;
+		int32 Components = 0;
+		int32 Effects = 0;
+		int32 Attributes = 0;
+		SIZE_T Bytes = 0;
+		TArray<FString> Lines;
+	};
+	TMap<const UWorld*, FWorldTotals> worlds;
+
+	for (TObjectIterator<UASComponent> it; it; ++it)
+	{
+		UASComponent* asComp = *it;
+		const UWorld* world = asComp->GetWorld();
+		if (!world || asComp->IsTemplate())
+			continue;
+
+		TArray<UEffect*> effects;
+		TArray<UAttribute*> attributes;
+		asComp->GetEffectList(effects);
+		asComp->GetAttributeList(attributes);
+		const SIZE_T bytes = asComp->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+		FWorldTotals& totals = worlds.FindOrAdd(world);
+		if (totals.Components == 0)
+		{
+			totals.Name = FString::Printf(TEXT("%s (%s)"), *world->GetName(), LexToString(world->WorldType));
+		}
+		++totals.Components;
+		totals.Effects += effects.Num();
+		totals.Attributes += attributes.Num();
+		totals.Bytes += bytes;
+
+		totals.Lines.Add(FString::Printf(TEXT("  %-48s effects: %4d attributes: %4d %10.2f KB"),
+		                                 *GetNameSafe(asComp->GetOwner()), effects.Num(), attributes.Num(),
+		                                 bytes / 1024.0));
+	}
+
+	for (const TPair<const UWorld*, FWorldTotals>& pair : worlds)
+	{
+		Ar.Logf(TEXT("World %s"), *pair.Value.Name);
+		for (const FString& line : pair.Value.Lines)
+		{
+			Ar.Log(line);
+		}
+	}
+
+	Ar.Logf(TEXT("Totals:"));
+	for (const TPair<const UWorld*, FWorldTotals>& pair : worlds)
+	{
+		const FWorldTotals& totals = pair.Value;
+		Ar.Logf(TEXT("  %-48s components: %5d effects: %6d attributes: %6d %10.2f KB"), *totals.Name,
+		        totals.Components, totals.Effects, totals.Attributes, totals.Bytes / 1024.0);
+	}
+}
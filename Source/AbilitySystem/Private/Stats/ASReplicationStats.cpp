@@ -0,0 +1,166 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Stats/ASReplicationStats.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace ASReplicationStats
+{
+	static int32 GEnabled = 0;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("as.NetStats.Enabled"),
+		GEnabled,
+		TEXT("Records replication bandwidth of ability system entities per class.\n")
+		TEXT("0: disabled (default), 1: enabled"),
+		ECVF_Default);
+
+	static FAutoConsoleCommandWithOutputDevice CmdDump(
+		TEXT("as.NetStats.Dump"),
+		TEXT("Prints replication bandwidth of ability system entities per class"),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			FASReplicationStats::Get().Dump(Ar);
+		}));
+
+	static FAutoConsoleCommand CmdReset(
+		TEXT("as.NetStats.Reset"),
+		TEXT("Clears recorded replication bandwidth of ability system entities"),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			FASReplicationStats::Get().Reset();
+		}));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdCsv(
+		TEXT("as.NetStats.Csv"),
+		TEXT("Writes replication bandwidth of ability system entities to a CSV file.\n")
+		TEXT("Usage: as.NetStats.Csv [FileName] (default: Profiling/AbilitySystem/NetStats-<Timestamp>.csv)"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda(
+			[](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+			{
+				FString fileName = Args.Num() > 0
+					                   ? Args[0]
+					                   : FString::Printf(
+						                   TEXT("NetStats-%s.csv"), *FDateTime::Now().ToString());
+				const FString filePath = FPaths::IsRelative(fileName)
+					                         ? FPaths::Combine(FPaths::ProfilingDir(), TEXT("AbilitySystem"), fileName)
+					                         : fileName;
+
+				if (FASReplicationStats::Get().WriteCsv(filePath))
+				{
+					Ar.Logf(TEXT("Net stats written to %s"), *filePath);
+				}
+				else
+				{
+					Ar.Logf(TEXT("Failed to write net stats to %s"), *filePath);
+				}
+			}));
+}
+
+FASReplicationStats& FASReplicationStats::Get()
+{
+	static FASReplicationStats instance;
+	return instance;
+}
+
+bool FASReplicationStats::IsEnabled()
+{
+	return ASReplicationStats::GEnabled != 0;
+}
+
+FASReplicationStatEntry& FASReplicationStats::FindOrAddEntry(const UClass* InClass)
+{
+	FASReplicationStatEntry& entry = Entries.FindOrAdd(FObjectKey(InClass));
+	if (entry.ClassName.IsEmpty())
+	{
+		entry.ClassName = GetPathNameSafe(InClass);
+	}
+	return entry;
+}
+
+void FASReplicationStats::RecordReplication(const UClass* InClass, int64 InNumBits, bool bInWroteData)
+{
+	if (!InClass)
+		return;
+
+	FASReplicationStatEntry& entry = FindOrAddEntry(InClass);
+	entry.Bits += InNumBits;
+	entry.Passes++;
+	if (bInWroteData)
+	{
+		entry.Updates++;
+	}
+}
+
+void FASReplicationStats::RecordPropertyUpdate(const UClass* InClass, FName InPropertyName)
+{
+	if (!InClass)
+		return;
+
+	FASReplicationStatEntry& entry = FindOrAddEntry(InClass);
+	entry.PropertyUpdates.FindOrAdd(InPropertyName)++;
+}
+
+void FASReplicationStats::Reset()
+{
+	Entries.Empty();
+}
+
+void FASReplicationStats::Dump(FOutputDevice& Ar) const
+{
+	TArray<const FASReplicationStatEntry*> sorted;
+	sorted.Reserve(Entries.Num());
+	int64 totalBits = 0;
+	for (const TPair<FObjectKey, FASReplicationStatEntry>& pair : Entries)
+	{
+		sorted.Add(&pair.Value);
+		totalBits += pair.Value.Bits;
+	}
+	sorted.Sort([](const FASReplicationStatEntry& A, const FASReplicationStatEntry& B)
+	{
+		return A.Bits > B.Bits;
+	});
+
+	Ar.Logf(TEXT("AbilitySystem net stats (%s, %d classes, %lld bytes total)"),
+	        IsEnabled() ? TEXT("recording") : TEXT("paused"), sorted.Num(), totalBits / 8);
+	Ar.Logf(TEXT("%12s %6s %10s %10s  %s"), TEXT("Bytes"), TEXT("%"), TEXT("Updates"), TEXT("Passes"),
+	        TEXT("Class"));
+
+	for (const FASReplicationStatEntry* entry : sorted)
+	{
+		const float share = totalBits > 0 ? 100.0f * entry->Bits / totalBits : 0.0f;
+		Ar.Logf(TEXT("%12lld %6.2f %10lld %10lld  %s"), entry->Bits / 8, share, entry->Updates, entry->Passes,
+		        *entry->ClassName);
+
+		for (const TPair<FName, int64>& prop : entry->PropertyUpdates)
+		{
+			Ar.Logf(TEXT("%12s %6s %10lld %10s    .%s"), TEXT(""), TEXT(""), prop.Value, TEXT(""),
+			        *prop.Key.ToString());
+		}
+	}
+}
+
+bool FASReplicationStats::WriteCsv(const FString& InFilePath) const
+{
+	TArray<FString> lines;
+	lines.Reserve(Entries.Num() + 1);
+	lines.Add(TEXT("Class,Property,Bytes,Bits,Updates,Passes"));
+
+	for (const TPair<FObjectKey, FASReplicationStatEntry>& pair : Entries)
+	{
+		const FASReplicationStatEntry& entry = pair.Value;
+		lines.Add(FString::Printf(TEXT("%s,,%lld,%lld,%lld,%lld"),
+		                          *entry.ClassName, entry.Bits / 8, entry.Bits, entry.Updates, entry.Passes));
+
+		for (const TPair<FName, int64>& prop : entry.PropertyUpdates)
+		{
+			lines.Add(FString::Printf(TEXT("%s,%s,,,%lld,"),
+			                          *entry.ClassName, *prop.Key.ToString(), prop.Value));
+		}
+	}
+
+	return FFileHelper::SaveStringArrayToFile(lines, *InFilePath);
+}
@@ -0,0 +1,195 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Subsystems/ASApplicationQueueSubsystem.h"
+
+#include "Components/ASComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Objects/Effects/Effect.h"
+
+namespace ASApplicationQueue
+{
+	static float GBudgetUs = 1000.0f;
+	static FAutoConsoleVariableRef CVarBudgetUs(
+		TEXT("as.ApplicationQueue.BudgetUs"),
+		GBudgetUs,
+		TEXT("Microseconds per frame spent adding queued effects, 0 processes everything in one frame."),
+		ECVF_Default);
+}
+
+void UASApplicationQueueSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Batches.Num() == 0)
+		return;
+
+	const float budgetUs = ASApplicationQueue::GBudgetUs;
+	const uint64 endCycles = budgetUs > 0.0f
+		                         ? FPlatformTime::Cycles64() + static_cast<uint64>(
+			                         budgetUs / (FPlatformTime::GetSecondsPerCycle64() * 1000000.0))
+		                         : 0;
+	Process(endCycles);
+}
+
+TStatId UASApplicationQueueSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UASApplicationQueueSubsystem, STATGROUP_Tickables);
+}
+
+void UASApplicationQueueSubsystem::Deinitialize()
+{
+	Batches.Empty();
+	Super::Deinitialize();
+}
+
+void UASApplicationQueueSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	// Blueprint effect classes must survive until their batch completes
+	for (FBatch& batch : CastChecked<UASApplicationQueueSubsystem>(InThis)->Batches)
+	{
+		Collector.AddReferencedObject(batch.EffectClass, InThis);
+	}
+}
+
+bool UASApplicationQueueSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+int32 UASApplicationQueueSubsystem::QueueEffect(const TArray<UASComponent*>& Targets,
+                                                TSubclassOf<UEffect> EffectClass, int32 Priority,
+                                                const FASApplicationBatchDelegate& OnCompleted,
+                                                const FASEffectContext& Context)
+{
+	const int32 id = QueueEffect(MakeArrayView(Targets), EffectClass, Priority, {}, Context);
+	if (id != 0)
+	{
+		Batches[FindBatchIndex(id)].OnCompleted = OnCompleted;
+	}
+	return id;
+}
+
+int32 UASApplicationQueueSubsystem::QueueEffect(TArrayView<UASComponent* const> InTargets,
+                                                TSubclassOf<UEffect> InEffectClass, int32 InPriority,
+                                                FASApplicationBatchNativeDelegate InOnCompleted,
+                                                const FASEffectContext& InContext)
+{
+	if (!InEffectClass || InTargets.Num() == 0 || GetWorld()->GetNetMode() == NM_Client)
+		return 0;
+
+	FBatch* batch = AddBatch(InEffectClass, InPriority);
+	batch->Targets.Reserve(InTargets.Num());
+	for (UASComponent* asComp : InTargets)
+	{
+		batch->Targets.Add(asComp);
+	}
+	batch->Instigator = InContext.Instigator;
+	batch->Source = InContext.Source;
+	batch->OnNativeCompleted = MoveTemp(InOnCompleted);
+	return batch->Id;
+}
+
+UASApplicationQueueSubsystem::FBatch* UASApplicationQueueSubsystem::AddBatch(TSubclassOf<UEffect> InEffectClass,
+                                                                           int32 InPriority)
+{
+	// After the last batch of the same or higher priority
+	int32 index = Batches.Num();
+	while (index > 0 && Batches[index - 1].Priority < InPriority)
+	{
+		--index;
+	}
+
+	FBatch& batch = Batches.InsertDefaulted_GetRef(index);
+	batch.Id = ++LastBatchId;
+	batch.Priority = InPriority;
+	batch.EffectClass = InEffectClass.Get();
+	return &batch;
+}
+
+bool UASApplicationQueueSubsystem::CancelBatch(int32 BatchId)
+{
+	const int32 index = FindBatchIndex(BatchId);
+	if (index == INDEX_NONE)
+		return false;
+
+	Batches.RemoveAt(index);
+	return true;
+}
+
+bool UASApplicationQueueSubsystem::IsBatchPending(int32 BatchId) const
+{
+	return FindBatchIndex(BatchId) != INDEX_NONE;
+}
+
+int32 UASApplicationQueueSubsystem::GetNumPending() const
+{
+	int32 num = 0;
+	for (const FBatch& batch : Batches)
+	{
+		num += batch.Targets.Num() - batch.Next;
+	}
+	return num;
+}
+
+void UASApplicationQueueSubsystem::Flush()
+{
+	Process(0);
+}
+
+void UASApplicationQueueSubsystem::Process(uint64 InEndCycles)
+{
+	// At least one target per call, so low budgets still make progress
+	do
+	{
+		ProcessNext();
+	}
+	while (Batches.Num() > 0 && (InEndCycles == 0 || FPlatformTime::Cycles64() < InEndCycles));
+}
+
+void UASApplicationQueueSubsystem::ProcessNext()
+{
+	if (Batches.Num() == 0)
+		return;
+
+	// Effect callbacks may queue or cancel batches, nothing is referenced across AddEffect
+	FBatch& batch = Batches[0];
+	const int32 id = batch.Id;
+
+	if (batch.Next < batch.Targets.Num())
+	{
+		const TSubclassOf<UEffect> effectClass = batch.EffectClass.Get();
+		const FASEffectContext context(batch.Instigator.Get(), batch.Source.Get());
+		UASComponent* asComp = batch.Targets[batch.Next++].Get();
+
+		if (IsValid(asComp) && (asComp->AddEffect(effectClass, context) || asComp->HasEffect(effectClass)))
+		{
+			const int32 index = FindBatchIndex(id);
+			if (index != INDEX_NONE)
+			{
+				++Batches[index].NumApplied;
+			}
+		}
+	}
+
+	const int32 index = FindBatchIndex(id);
+	if (index == INDEX_NONE || Batches[index].Next < Batches[index].Targets.Num())
+		return;
+
+	FBatch completed = MoveTemp(Batches[index]);
+	Batches.RemoveAt(index);
+
+	completed.OnCompleted.ExecuteIfBound(completed.Id, completed.NumApplied);
+	completed.OnNativeCompleted.ExecuteIfBound(completed.Id, completed.NumApplied);
+}
+
+int32 UASApplicationQueueSubsystem::FindBatchIndex(int32 InId) const
+{
+	return Batches.IndexOfByPredicate([InId](const FBatch& InBatch)
+	{
+		return InBatch.Id == InId;
+	});
+}
@@ -0,0 +1,245 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Subsystems/ASIndexSubsystem.h"
+
+#include "Components/ASComponent.h"
+#include "Engine/World.h"
+#include "Objects/ASClassRegistry.h"
+#include "Objects/Attribute.h"
+#include "Objects/Effects/Effect.h"
+
+void UASIndexSubsystem::Deinitialize()
+{
+	Components.Empty();
+	ComponentsByClassId.Empty();
+	ComponentsByClass.Empty();
+	EffectsByInstigator.Empty();
+	Super::Deinitialize();
+}
+
+bool UASIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UASIndexSubsystem::RegisterComponent(UASComponent* InComponent)
+{
+	if (IsValid(InComponent))
+	{
+		Components.Add(InComponent);
+	}
+}
+
+void UASIndexSubsystem::UnregisterComponent(UASComponent* InComponent)
+{
+	Components.Remove(InComponent);
+}
+
+void UASIndexSubsystem::AddEntityClass(UASComponent* InComponent, const UClass* InClass)
+{
+	// Up to UEffect, UAttribute or UAbility, so each of them matches every entity of its kind
+	for (const UClass* entityClass = InClass; entityClass && entityClass != UBasicAsEntity::StaticClass();
+	     entityClass = entityClass->GetSuperClass())
+	{
+		++FindOrAddClassComponents(entityClass).FindOrAdd(InComponent);
+	}
+}
+
+void UASIndexSubsystem::RemoveEntityClass(UASComponent* InComponent, const UClass* InClass)
+{
+	for (const UClass* entityClass = InClass; entityClass && entityClass != UBasicAsEntity::StaticClass();
+	     entityClass = entityClass->GetSuperClass())
+	{
+		FClassComponents* components = FindClassComponents(entityClass);
+		if (!components)
+			continue;
+
+		int32* num = components->Find(InComponent);
+		if (num && --*num <= 0)
+		{
+			components->Remove(InComponent);
+			if (components->Num() == 0)
+			{
+				RemoveClassComponents(entityClass);
+			}
+		}
+	}
+}
+
+void UASIndexSubsystem::GetComponents(TArray<UASComponent*>& OutComponents) const
+{
+	OutComponents.Reset(Components.Num());
+	for (const TWeakObjectPtr<UASComponent>& component : Components)
+	{
+		if (UASComponent* asComp = component.Get())
+		{
+			OutComponents.Add(asComp);
+		}
+	}
+}
+
+void UASIndexSubsystem::GetComponentsWithEffect(TSubclassOf<UEffect> EffectClass,
+                                                TArray<UASComponent*>& OutComponents) const
+{
+	OutComponents.Reset();
+	ForEachComponentWithClass(EffectClass, [&OutComponents](UASComponent* InComponent)
+	{
+		OutComponents.Add(InComponent);
+	});
+}
+
+int32 UASIndexSubsystem::CountComponentsWithEffect(TSubclassOf<UEffect> EffectClass) const
+{
+	int32 num = 0;
+	ForEachComponentWithClass(EffectClass, [&num](UASComponent*) { ++num; });
+	return num;
+}
+
+void UASIndexSubsystem::GetComponentsWithAttribute(TSubclassOf<UAttribute> AttributeClass,
+                                                   TArray<UASComponent*>& OutComponents) const
+{
+	OutComponents.Reset();
+	ForEachComponentWithClass(AttributeClass, [&OutComponents](UASComponent* InComponent)
+	{
+		OutComponents.Add(InComponent);
+	});
+}
+
+int32 UASIndexSubsystem::CountComponentsWithAttribute(TSubclassOf<UAttribute> AttributeClass) const
+{
+	int32 num = 0;
+	ForEachComponentWithClass(AttributeClass, [&num](UASComponent*) { ++num; });
+	return num;
+}
+
+void UASIndexSubsystem::ForEachComponentWithClass(const UClass* InClass,
+                                                  TFunctionRef<void(UASComponent*)> InFunction) const
+{
+	if (!InClass)
+		return;
+
+	if (const FClassComponents* components = FindClassComponents(InClass))
+	{
+		for (const TPair<TWeakObjectPtr<UASComponent>, int32>& pair : *components)
+		{
+			if (UASComponent* asComp = pair.Key.Get())
+			{
+				InFunction(asComp);
+			}
+		}
+	}
+}
+
+const UASIndexSubsystem::FClassComponents* UASIndexSubsystem::FindClassComponents(const UClass* InClass) const
+{
+	const uint16 id = FASClassRegistry::GetId(InClass);
+	if (id != FASClassRegistry::InvalidId)
+	{
+		return ComponentsByClassId.IsValidIndex(id) ? &ComponentsByClassId[id] : nullptr;
+	}
+	return ComponentsByClass.Find(InClass);
+}
+
+UASIndexSubsystem::FClassComponents& UASIndexSubsystem::FindOrAddClassComponents(const UClass* InClass)
+{
+	const uint16 id = FASClassRegistry::GetId(InClass);
+	if (id != FASClassRegistry::InvalidId)
+	{
+		if (!ComponentsByClassId.IsValidIndex(id))
+		{
+			ComponentsByClassId.SetNum(FMath::Max<int32>(id, FASClassRegistry::Num()) + 1);
+		}
+		return ComponentsByClassId[id];
+	}
+	return ComponentsByClass.FindOrAdd(InClass);
+}
+
+void UASIndexSubsystem::RemoveClassComponents(const UClass* InClass)
+{
+	const uint16 id = FASClassRegistry::GetId(InClass);
+	if (id != FASClassRegistry::InvalidId)
+	{
+		// Keeps the slot, frees the allocation
+		ComponentsByClassId[id].Empty();
+		return;
+	}
+	ComponentsByClass.Remove(InClass);
+}
+
+void UASIndexSubsystem::AddInstigatedEffect(UEffect* InEffect, FObjectKey InInstigator)
+{
+	EffectsByInstigator.FindOrAdd(InInstigator).Add(InEffect);
+}
+
+void UASIndexSubsystem::RemoveInstigatedEffect(UEffect* InEffect, FObjectKey InInstigator)
+{
+	if (TArray<TWeakObjectPtr<UEffect>>* effects = EffectsByInstigator.Find(InInstigator))
+	{
+		effects->RemoveSingleSwap(InEffect, false);
+		if (effects->Num() == 0)
+		{
+			EffectsByInstigator.Remove(InInstigator);
+		}
+	}
+}
+
+void UASIndexSubsystem::GetEffectsByInstigator(AActor* Instigator, TArray<UEffect*>& OutEffects) const
+{
+	OutEffects.Reset();
+	if (const TArray<TWeakObjectPtr<UEffect>>* effects = EffectsByInstigator.Find(Instigator))
+	{
+		for (const TWeakObjectPtr<UEffect>& effect : *effects)
+		{
+			if (UEffect* entity = effect.Get())
+			{
+				OutEffects.Add(entity);
+			}
+		}
+	}
+}
+
+int32 UASIndexSubsystem::CountEffectsByInstigator(AActor* Instigator, TSubclassOf<UEffect> EffectClass) const
+{
+	int32 num = 0;
+	if (const TArray<TWeakObjectPtr<UEffect>>* effects = EffectsByInstigator.Find(Instigator))
+	{
+		for (const TWeakObjectPtr<UEffect>& effect : *effects)
+		{
+			const UEffect* entity = effect.Get();
+			if (entity && (!EffectClass || entity->IsA(EffectClass)))
+			{
+				++num;
+			}
+		}
+	}
+	return num;
+}
+
+int32 UASIndexSubsystem::RemoveEffectsByInstigator(AActor* Instigator, TSubclassOf<UEffect> EffectClass)
+{
+	const TArray<TWeakObjectPtr<UEffect>>* effects = EffectsByInstigator.Find(Instigator);
+	if (!effects)
+		return 0;
+
+	// Removal changes the index, components count what they actually removed
+	TArray<TWeakObjectPtr<UASComponent>, TInlineAllocator<8>> components;
+	for (const TWeakObjectPtr<UEffect>& effect : *effects)
+	{
+		const UEffect* entity = effect.Get();
+		if (UASComponent* asComp = entity ? entity->GetOwningComponent() : nullptr)
+		{
+			components.AddUnique(asComp);
+		}
+	}
+
+	int32 num = 0;
+	for (const TWeakObjectPtr<UASComponent>& weakComp : components)
+	{
+		if (UASComponent* asComp = weakComp.Get())
+		{
+			num += asComp->RemoveEffectsByInstigator(Instigator, EffectClass);
+		}
+	}
+	return num;
+}
@@ -0,0 +1,136 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Subsystems/ASParallelTickSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Objects/Attribute.h"
+#include "Objects/Effects/Effect.h"
+
+namespace ASParallelTick
+{
+	static int32 GMinBatchSize = 64;
+	static FAutoConsoleVariableRef CVarMinBatchSize(
+		TEXT("as.ParallelTick.MinBatchSize"),
+		GMinBatchSize,
+		TEXT("Minimum number of queued periodic ticks to evaluate them across worker threads."),
+		ECVF_Default);
+
+	/** Merged writes of a single attribute */
+	struct FMergedWrite
+	{
+		UAttribute* Attribute = nullptr;
+		float Base = 0.0f;
+		float Delta = 0.0f;
+		bool bHasBase = false;
+	};
+}
+
+void UASParallelTickSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	Flush();
+}
+
+TStatId UASParallelTickSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UASParallelTickSubsystem, STATGROUP_Tickables);
+}
+
+void UASParallelTickSubsystem::Deinitialize()
+{
+	PendingTicks.Empty();
+	QueuedEffects.Empty();
+	Super::Deinitialize();
+}
+
+bool UASParallelTickSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UASParallelTickSubsystem::QueuePeriodTick(UEffect* InEffect)
+{
+	if (IsValid(InEffect))
+	{
+		PendingTicks.Add(InEffect);
+		QueuedEffects.Add(InEffect);
+	}
+}
+
+void UASParallelTickSubsystem::FlushIfQueued(const UEffect* InEffect)
+{
+	if (QueuedEffects.Contains(InEffect))
+	{
+		Flush();
+	}
+}
+
+void UASParallelTickSubsystem::Flush()
+{
+	if (PendingTicks.Num() == 0)
+		return;
+
+	TArray<UEffect*> batch;
+	batch.Reserve(PendingTicks.Num());
+	for (const TWeakObjectPtr<UEffect>& weakEffect : PendingTicks)
+	{
+		// Skip effects removed after their tick was queued
+		UEffect* effect = weakEffect.Get();
+		if (IsValid(effect) && !effect->HasAnyFlags(RF_BeginDestroyed))
+		{
+			batch.Add(effect);
+		}
+	}
+	PendingTicks.Reset();
+	QueuedEffects.Reset();
+
+	// Evaluation phase: effects only read attributes and fill their own buffer
+	TArray<FASAttributeWriteBuffer> buffers;
+	buffers.SetNum(batch.Num());
+	ParallelFor(batch.Num(), [&batch, &buffers](int32 Index)
+	{
+		batch[Index]->EvaluatePeriodTick(buffers[Index]);
+	}, batch.Num() < ASParallelTick::GMinBatchSize ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	// Merge phase: keep the order of the first write of every attribute
+	TArray<ASParallelTick::FMergedWrite> merged;
+	TMap<UAttribute*, int32> mergedIndices;
+	for (const FASAttributeWriteBuffer& buffer : buffers)
+	{
+		for (const FASAttributeWrite& write : buffer.Writes)
+		{
+			if (!write.Attribute)
+				continue;
+
+			int32& index = mergedIndices.FindOrAdd(write.Attribute, INDEX_NONE);
+			if (index == INDEX_NONE)
+			{
+				index = merged.Add(ASParallelTick::FMergedWrite{write.Attribute});
+			}
+
+			ASParallelTick::FMergedWrite& entry = merged[index];
+			if (write.Op == EASAttributeWriteOp::Set)
+			{
+				entry.Base = write.Value;
+				entry.Delta = 0.0f;
+				entry.bHasBase = true;
+			}
+			else
+			{
+				entry.Delta += write.Value;
+			}
+		}
+	}
+
+	// Apply phase: a single SetValue (and broadcast) per attribute
+	for (const ASParallelTick::FMergedWrite& entry : merged)
+	{
+		if (IsValid(entry.Attribute))
+		{
+			const float base = entry.bHasBase ? entry.Base : entry.Attribute->GetCurrentValue();
+			entry.Attribute->SetValue(base + entry.Delta);
+		}
+	}
+}
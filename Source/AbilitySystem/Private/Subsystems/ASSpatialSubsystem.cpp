@@ -0,0 +1,348 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Subsystems/ASSpatialSubsystem.h"
+
+#include "Components/ASComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GenericTeamAgentInterface.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeExit.h"
+#include "Objects/Effects/Effect.h"
+
+namespace ASSpatial
+{
+	static float GCellSize = 1000.0f;
+	static FAutoConsoleVariableRef CVarCellSize(
+		TEXT("as.Spatial.CellSize"),
+		GCellSize,
+		TEXT("Cell size of the ability system spatial index in world units, entries are rehashed on the next query."),
+		ECVF_Default);
+}
+
+void UASSpatialSubsystem::Deinitialize()
+{
+	for (FEntry& entry : Entries)
+	{
+		if (USceneComponent* root = entry.Root.Get())
+		{
+			root->TransformUpdated.Remove(entry.MovedHandle);
+		}
+	}
+	Entries.Empty();
+	FreeEntries.Empty();
+	DirtyEntries.Empty();
+	Indices.Empty();
+	Cells.Empty();
+	Super::Deinitialize();
+}
+
+bool UASSpatialSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UASSpatialSubsystem::Register(UASComponent* InComponent)
+{
+	if (!IsValid(InComponent) || Indices.Contains(InComponent))
+		return;
+
+	if (CellSize <= 0.0f)
+	{
+		CellSize = FMath::Max(ASSpatial::GCellSize, 1.0f);
+	}
+
+	const int32 index = FreeEntries.Num() > 0 ? FreeEntries.Pop(false) : Entries.AddDefaulted();
+	FEntry& entry = Entries[index];
+	entry.Component = InComponent;
+	entry.Location = InComponent->GetOwner()->GetActorLocation();
+	entry.Cell = GetCell(entry.Location);
+
+	if (USceneComponent* root = InComponent->GetOwner()->GetRootComponent())
+	{
+		entry.Root = root;
+		entry.MovedHandle = root->TransformUpdated.AddUObject(this, &UASSpatialSubsystem::OnOwnerMoved, index);
+	}
+
+	AddToCell(index);
+	Indices.Add(InComponent, index);
+}
+
+void UASSpatialSubsystem::Unregister(UASComponent* InComponent)
+{
+	if (const int32* index = Indices.Find(InComponent))
+	{
+		ReleaseEntry(*index);
+	}
+}
+
+void UASSpatialSubsystem::ReleaseEntry(int32 InIndex)
+{
+	FEntry& entry = Entries[InIndex];
+	if (USceneComponent* root = entry.Root.Get())
+	{
+		root->TransformUpdated.Remove(entry.MovedHandle);
+	}
+
+	RemoveFromCell(InIndex);
+	Indices.Remove(entry.Component);
+	entry = FEntry();
+	FreeEntries.Add(InIndex);
+}
+
+void UASSpatialSubsystem::OnOwnerMoved(USceneComponent* InRoot, EUpdateTransformFlags InFlags,
+                                       ETeleportType InTeleport, int32 InIndex)
+{
+	FEntry& entry = Entries[InIndex];
+	if (!entry.bDirty)
+	{
+		entry.bDirty = true;
+		DirtyEntries.Add(InIndex);
+	}
+}
+
+void UASSpatialSubsystem::Refresh()
+{
+	if (LastRefreshFrame == GFrameCounter)
+		return;
+	LastRefreshFrame = GFrameCounter;
+
+	// Cell size changed, every entry has to be rehashed once
+	const float cellSize = FMath::Max(ASSpatial::GCellSize, 1.0f);
+	if (cellSize != CellSize)
+	{
+		CellSize = cellSize;
+		Cells.Reset();
+		DirtyEntries.Reset();
+		for (int32 i = 0; i < Entries.Num(); ++i)
+		{
+			FEntry& entry = Entries[i];
+			if (!entry.Component.IsExplicitlyNull())
+			{
+				entry.Cell = GetCell(entry.Location);
+				AddToCell(i);
+				entry.bDirty = true;
+				DirtyEntries.Add(i);
+			}
+		}
+	}
+
+	for (const int32 index : DirtyEntries)
+	{
+		FEntry& entry = Entries[index];
+		entry.bDirty = false;
+
+		// Released after it moved
+		if (entry.Component.IsExplicitlyNull())
+			continue;
+
+		const UASComponent* asComp = entry.Component.Get();
+		const AActor* owner = asComp ? asComp->GetOwner() : nullptr;
+		if (!owner)
+		{
+			// Destroyed without EndPlay
+			ReleaseEntry(index);
+			continue;
+		}
+
+		entry.Location = owner->GetActorLocation();
+		const FIntVector cell = GetCell(entry.Location);
+		if (cell != entry.Cell)
+		{
+			RemoveFromCell(index);
+			entry.Cell = cell;
+			AddToCell(index);
+		}
+	}
+	DirtyEntries.Reset();
+}
+
+void UASSpatialSubsystem::QueryRadius(FVector Center, float Radius, const FASSpatialFilter& Filter,
+                                      AActor* Instigator, TArray<UASComponent*>& OutComponents)
+{
+	const double radiusSquared = FMath::Square(static_cast<double>(Radius));
+	Query(FBox(Center - FVector(Radius), Center + FVector(Radius)), [&](const FVector& InLocation)
+	{
+		return FVector::DistSquared(InLocation, Center) <= radiusSquared;
+	}, Filter, Instigator, OutComponents);
+}
+
+void UASSpatialSubsystem::QueryBox(FVector Center, FVector Extent, const FASSpatialFilter& Filter, AActor* Instigator,
+                                   TArray<UASComponent*>& OutComponents)
+{
+	const FBox box(Center - Extent, Center + Extent);
+	Query(box, [&](const FVector& InLocation)
+	{
+		return box.IsInsideOrOn(InLocation);
+	}, Filter, Instigator, OutComponents);
+}
+
+int32 UASSpatialSubsystem::ApplyEffectInRadius(TSubclassOf<UEffect> EffectClass, FVector Center, float Radius,
+                                               const FASSpatialFilter& Filter, AActor* Instigator)
+{
+	TArray<UASComponent*> components;
+	QueryRadius(Center, Radius, Filter, Instigator, components);
+	return ApplyEffect(EffectClass, components, FASEffectContext(Instigator));
+}
+
+int32 UASSpatialSubsystem::ApplyEffectInBox(TSubclassOf<UEffect> EffectClass, FVector Center, FVector Extent,
+                                            const FASSpatialFilter& Filter, AActor* Instigator)
+{
+	TArray<UASComponent*> components;
+	QueryBox(Center, Extent, Filter, Instigator, components);
+	return ApplyEffect(EffectClass, components, FASEffectContext(Instigator));
+}
+
+void UASSpatialSubsystem::Query(const FBox& InBox, TFunctionRef<bool(const FVector&)> InContains,
+                                const FASSpatialFilter& InFilter, const AActor* InInstigator,
+                                TArray<UASComponent*>& OutComponents)
+{
+	OutComponents.Reset();
+	Refresh();
+
+	// Destroyed without EndPlay, released once the cells are no longer iterated
+	TArray<int32, TInlineAllocator<4>> staleEntries;
+	ON_SCOPE_EXIT
+	{
+		for (const int32 index : staleEntries)
+		{
+			ReleaseEntry(index);
+		}
+	};
+
+	auto visit = [&](int32 InIndex)
+	{
+		const FEntry& entry = Entries[InIndex];
+		UASComponent* asComp = entry.Component.Get();
+		if (!asComp)
+		{
+			staleEntries.Add(InIndex);
+		}
+		else if (InContains(entry.Location) && PassesFilter(asComp, InFilter, InInstigator))
+		{
+			OutComponents.Add(asComp);
+		}
+	};
+
+	const FIntVector minCell = GetCell(InBox.Min);
+	const FIntVector maxCell = GetCell(InBox.Max);
+	const int64 numCells = static_cast<int64>(maxCell.X - minCell.X + 1) * (maxCell.Y - minCell.Y + 1) *
+		(maxCell.Z - minCell.Z + 1);
+
+	// Large boxes are cheaper to test against occupied cells only
+	if (numCells > Cells.Num())
+	{
+		for (const auto& pair : Cells)
+		{
+			const FIntVector& cell = pair.Key;
+			if (cell.X >= minCell.X && cell.X <= maxCell.X && cell.Y >= minCell.Y && cell.Y <= maxCell.Y &&
+				cell.Z >= minCell.Z && cell.Z <= maxCell.Z)
+			{
+				for (const int32 index : pair.Value)
+				{
+					visit(index);
+				}
+			}
+		}
+		return;
+	}
+
+	for (int32 x = minCell.X; x <= maxCell.X; ++x)
+	{
+		for (int32 y = minCell.Y; y <= maxCell.Y; ++y)
+		{
+			for (int32 z = minCell.Z; z <= maxCell.Z; ++z)
+			{
+				if (const auto* cell = Cells.Find(FIntVector(x, y, z)))
+				{
+					for (const int32 index : *cell)
+					{
+						visit(index);
+					}
+				}
+			}
+		}
+	}
+}
+
+int32 UASSpatialSubsystem::ApplyEffect(TSubclassOf<UEffect> InEffectClass,
+                                       TArrayView<UASComponent* const> InComponents,
+                                       const FASEffectContext& InContext)
+{
+	if (!InEffectClass || GetWorld()->GetNetMode() == NM_Client)
+		return 0;
+
+	int32 num = 0;
+	for (UASComponent* asComp : InComponents)
+	{
+		// Effects applied earlier in the pass may have destroyed owners
+		if (!IsValid(asComp))
+			continue;
+
+		if (asComp->AddEffect(InEffectClass, InContext) || asComp->HasEffect(InEffectClass))
+		{
+			++num;
+		}
+	}
+	return num;
+}
+
+bool UASSpatialSubsystem::PassesFilter(const UASComponent* InComponent, const FASSpatialFilter& InFilter,
+                                       const AActor* InInstigator) const
+{
+	const AActor* owner = InComponent->GetOwner();
+	if (!IsValid(owner))
+		return false;
+
+	if (InFilter.bExcludeInstigator && owner == InInstigator)
+		return false;
+
+	if (!InFilter.RequiredTag.IsNone() && !owner->ActorHasTag(InFilter.RequiredTag))
+		return false;
+
+	if (!InFilter.ExcludedTag.IsNone() && owner->ActorHasTag(InFilter.ExcludedTag))
+		return false;
+
+	if (InFilter.Team == EASTeamFilter::Any)
+		return true;
+
+	const ETeamAttitude::Type attitude = FGenericTeamId::GetAttitude(InInstigator, owner);
+	switch (InFilter.Team)
+	{
+	case EASTeamFilter::Friendly:
+		return attitude == ETeamAttitude::Friendly;
+	case EASTeamFilter::Neutral:
+		return attitude == ETeamAttitude::Neutral;
+	case EASTeamFilter::Hostile:
+		return attitude == ETeamAttitude::Hostile;
+	case EASTeamFilter::NotFriendly:
+		return attitude != ETeamAttitude::Friendly;
+	default:
+		return true;
+	}
+}
+
+FIntVector UASSpatialSubsystem::GetCell(const FVector& InLocation) const
+{
+	return FIntVector(FMath::FloorToInt32(InLocation.X / CellSize), FMath::FloorToInt32(InLocation.Y / CellSize),
+	                  FMath::FloorToInt32(InLocation.Z / CellSize));
+}
+
+void UASSpatialSubsystem::AddToCell(int32 InIndex)
+{
+	Cells.FindOrAdd(Entries[InIndex].Cell).Add(InIndex);
+}
+
+void UASSpatialSubsystem::RemoveFromCell(int32 InIndex)
+{
+	const FIntVector& cellKey = Entries[InIndex].Cell;
+	if (auto* cell = Cells.Find(cellKey))
+	{
+		cell->RemoveSingleSwap(InIndex, false);
+		if (cell->Num() == 0)
+		{
+			Cells.Remove(cellKey);
+		}
+	}
+}
@@ -0,0 +1,64 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Time/ASEffectScheduler.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ASEffectSchedulerTests
+{
+	FTimerDelegate Append(FString& OutOrder, TCHAR InName)
+	{
+		return FTimerDelegate::CreateLambda([&OutOrder, InName]()
+		{
+			OutOrder.AppendChar(InName);
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FASEffectSchedulerOrderTest, "AbilitySystem.Scheduler.Order",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FASEffectSchedulerOrderTest::RunTest(const FString& Parameters)
+{
+	using ASEffectSchedulerTests::Append;
+
+	FASEffectScheduler scheduler;
+	FString order;
+	FASEffectTimerHandle a, b, c, d, loop;
+
+	scheduler.SetTimer(a, Append(order, TEXT('A')), 2.0f, false);
+	scheduler.SetTimer(b, Append(order, TEXT('B')), 1.0f, false);
+	scheduler.SetTimer(c, Append(order, TEXT('C')), 1.0f, false);
+	scheduler.SetTimer(d, Append(order, TEXT('D')), 1.0f, false);
+	scheduler.ClearTimer(d);
+
+	scheduler.AdvanceTo(0.5);
+	TestEqual(TEXT("Nothing is due yet"), order, FString());
+
+	scheduler.AdvanceTo(2.0);
+	TestEqual(TEXT("Due time first, then scheduling order, cleared timers never fire"), order, FString(TEXT("BCA")));
+	TestEqual(TEXT("Time stops at the requested time"), scheduler.GetTime(), 2.0);
+
+	// Rescheduling moves a timer behind the ones scheduled before it
+	order.Reset();
+	scheduler.SetTimer(b, Append(order, TEXT('B')), 1.0f, false);
+	scheduler.SetTimer(c, Append(order, TEXT('C')), 1.0f, false);
+	scheduler.SetTimer(b, Append(order, TEXT('B')), 1.0f, false);
+	scheduler.AdvanceTo(3.0);
+	TestEqual(TEXT("Same due time fires in (re)scheduling order"), order, FString(TEXT("CB")));
+
+	// Looping timers are rescheduled from their previous due time
+	order.Reset();
+	scheduler.SetTimer(loop, Append(order, TEXT('L')), 0.5f, true);
+	scheduler.AdvanceTo(4.25);
+	TestEqual(TEXT("Looping timer fires once per period"), order, FString(TEXT("LL")));
+	TestEqual(TEXT("Looping timer does not drift"), scheduler.GetTimerRemaining(loop), 0.25f);
+
+	scheduler.Reset();
+	TestFalse(TEXT("Reset clears timers"), scheduler.IsTimerActive(loop));
+	return true;
+}
+
+#endif
@@ -0,0 +1,35 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Formula/ASFormula.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ASFormulaTests
+{
+	/** Result of the expression, MAX_flt if it does not compile */
+	float Evaluate(const TCHAR* InExpression)
+	{
+		FASFormula formula;
+		formula.Expression = InExpression;
+		return formula.Compile() ? formula.Evaluate(FASFormulaContext()) : MAX_flt;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FASFormulaPrecedenceTest, "AbilitySystem.Formula.Precedence",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FASFormulaPrecedenceTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("-2^2"), ASFormulaTests::Evaluate(TEXT("-2^2")), -4.0f);
+	TestEqual(TEXT("(-2)^2"), ASFormulaTests::Evaluate(TEXT("(-2)^2")), 4.0f);
+	TestEqual(TEXT("2^-1"), ASFormulaTests::Evaluate(TEXT("2^-1")), 0.5f);
+	TestEqual(TEXT("2^3^2"), ASFormulaTests::Evaluate(TEXT("2^3^2")), 512.0f);
+	TestEqual(TEXT("-2*3"), ASFormulaTests::Evaluate(TEXT("-2*3")), -6.0f);
+	TestEqual(TEXT("1-2^2"), ASFormulaTests::Evaluate(TEXT("1-2^2")), -3.0f);
+	TestEqual(TEXT("2*3+4"), ASFormulaTests::Evaluate(TEXT("2*3+4")), 10.0f);
+	return true;
+}
+
+#endif
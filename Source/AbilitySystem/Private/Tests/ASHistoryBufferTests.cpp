@@ -0,0 +1,49 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "History/ASHistoryBuffer.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FASHistoryBufferWrapTest, "AbilitySystem.History.Wrap",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FASHistoryBufferWrapTest::RunTest(const FString& Parameters)
+{
+	FASHistoryBuffer history;
+	history.Init(4);
+
+	FASHistoryRecord record;
+	for (int32 i = 1; i <= 4; ++i)
+	{
+		record.Time = i;
+		record.Value = i;
+		history.Add(record);
+	}
+
+	TestFalse(TEXT("Full buffer has not wrapped"), history.HasWrapped());
+	TestTrue(TEXT("Times before the first record are covered until it wraps"), history.Covers(0.5));
+
+	for (int32 i = 5; i <= 6; ++i)
+	{
+		record.Time = i;
+		record.Value = i;
+		history.Add(record);
+	}
+
+	TestTrue(TEXT("Buffer has wrapped"), history.HasWrapped());
+	TestEqual(TEXT("Count is capped by the capacity"), history.Num(), 4);
+	TestEqual(TEXT("Newest record"), history.GetFromNewest(0).Value, 6.0f);
+	TestEqual(TEXT("Oldest record"), history.GetFromNewest(3).Value, 3.0f);
+	TestFalse(TEXT("Overwritten times are not covered"), history.Covers(2.5));
+	TestTrue(TEXT("Oldest record time is covered"), history.Covers(3.0));
+	TestTrue(TEXT("Later times are covered"), history.Covers(10.0));
+
+	history.Reset();
+	TestFalse(TEXT("Reset clears the wrap"), history.HasWrapped());
+	TestTrue(TEXT("Empty buffer covers any time"), history.Covers(0.0));
+	return true;
+}
+
+#endif
@@ -0,0 +1,111 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+
+#include "Time/ASEffectScheduler.h"
+
+namespace ASEffectScheduler
+{
+	static constexpr float MinRate = 0.0001f;
+	static constexpr int32 CompactSlack = 64;
+}
+
+void FASEffectScheduler::SetTimer(FASEffectTimerHandle& InOutHandle, const FTimerDelegate& InDelegate, float InRate,
+                                  bool bInLoop, float InFirstDelay)
+{
+	ClearTimer(InOutHandle);
+
+	const uint64 id = NextId++;
+	FTimer& timer = Timers.Add(id);
+	timer.Delegate = InDelegate;
+	timer.Rate = FMath::Max(InRate, ASEffectScheduler::MinRate);
+	timer.bLoop = bInLoop;
+	timer.DueTime = Time + (InFirstDelay >= 0.0f ? InFirstDelay : timer.Rate);
+	Enqueue(id, timer);
+
+	InOutHandle.Id = id;
+}
+
+void FASEffectScheduler::ClearTimer(FASEffectTimerHandle& InOutHandle)
+{
+	if (InOutHandle.IsValid())
+	{
+		Timers.Remove(InOutHandle.Id);
+		InOutHandle.Invalidate();
+	}
+}
+
+bool FASEffectScheduler::IsTimerActive(const FASEffectTimerHandle& InHandle) const
+{
+	return InHandle.IsValid() && Timers.Contains(InHandle.Id);
+}
+
+float FASEffectScheduler::GetTimerRemaining(const FASEffectTimerHandle& InHandle) const
+{
+	const FTimer* timer = InHandle.IsValid() ? Timers.Find(InHandle.Id) : nullptr;
+	return timer ? static_cast<float>(timer->DueTime - Time) : -1.0f;
+}
+
+float FASEffectScheduler::GetTimerRate(const FASEffectTimerHandle& InHandle) const
+{
+	const FTimer* timer = InHandle.IsValid() ? Timers.Find(InHandle.Id) : nullptr;
+	return timer ? timer->Rate : -1.0f;
+}
+
+void FASEffectScheduler::Enqueue(uint64 InId, FTimer& InTimer)
+{
+	// Restarted timers (e.g. refreshed durations) leave stale entries behind, drop them once they pile up
+	if (Queue.Num() > Timers.Num() * 2 + ASEffectScheduler::CompactSlack)
+	{
+		Queue.RemoveAllSwap([this](const FQueueEntry& Entry)
+		{
+			const FTimer* timer = Timers.Find(Entry.Id);
+			return !timer || timer->Sequence != Entry.Sequence;
+		}, false);
+		Queue.Heapify(FQueueEntryPredicate());
+	}
+
+	InTimer.Sequence = NextSequence++;
+	Queue.HeapPush(FQueueEntry{InTimer.DueTime, InTimer.Sequence, InId}, FQueueEntryPredicate());
+}
+
+void FASEffectScheduler::AdvanceTo(double InTime)
+{
+	if (InTime <= Time)
+		return;
+
+	while (Queue.Num() > 0 && Queue.HeapTop().DueTime <= InTime)
+	{
+		FQueueEntry entry;
+		Queue.HeapPop(entry, FQueueEntryPredicate(), false);
+
+		FTimer* timer = Timers.Find(entry.Id);
+		// Cleared or rescheduled in the meantime
+		if (!timer || timer->Sequence != entry.Sequence)
+			continue;
+
+		Time = entry.DueTime;
+
+		// Callback may add or clear timers, keep a copy of the delegate
+		const FTimerDelegate delegate = timer->Delegate;
+		if (timer->bLoop)
+		{
+			timer->DueTime += timer->Rate;
+			Enqueue(entry.Id, *timer);
+		}
+		else
+		{
+			Timers.Remove(entry.Id);
+		}
+
+		delegate.ExecuteIfBound();
+	}
+
+	Time = InTime;
+}
+
+void FASEffectScheduler::Reset()
+{
+	Timers.Empty();
+	Queue.Empty();
+	Time = 0.0;
+}
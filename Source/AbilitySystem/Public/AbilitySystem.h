@@ -1,10 +1,12 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
+﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
 #pragma once
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+ABILITYSYSTEM_API DECLARE_LOG_CATEGORY_EXTERN(LogAbilitySystem, Log, All);
+
 class FAbilitySystemModule : public IModuleInterface
 {
 public:
@@ -0,0 +1,88 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "ASAsyncAction.generated.h"
+
+class UASComponent;
+
+/**
+ * @enum EASAsyncComparison
+ * @brief Comparison used by async wait nodes to test a value against a threshold.
+ */
+UENUM(BlueprintType)
+enum class EASAsyncComparison : uint8
+{
+	Less,
+	LessOrEqual,
+	Greater,
+	GreaterOrEqual,
+	Equal,
+	NotEqual,
+};
+
+/**
+ * @class UASAsyncAction
+ * @brief Base of latent Blueprint nodes waiting for UASComponent events.
+ *
+ * Nodes are driven by native events of the component and its entities, nothing is ticked.
+ * The node is cleaned up when it is cancelled, when it has triggered with bTriggerOnce,
+ * or when the owner of the component is destroyed.
+ */
+UCLASS(Abstract)
+class ABILITYSYSTEM_API UASAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Activate() override;
+	virtual void SetReadyToDestroy() override;
+
+	/**
+	 * @brief Stops waiting, no outputs are triggered after this call.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Async")
+	void Cancel();
+
+	/**
+	 * @brief Compares a value with a threshold.
+	 */
+	static bool Compare(float InValue, EASAsyncComparison InComparison, float InThreshold);
+
+protected:
+	/**
+	 * @brief Stores the component and registers the node with its game instance.
+	 */
+	void Init(UASComponent* InComponent, bool bInTriggerOnce);
+
+	/**
+	 * @brief Binds the events of the component the node waits for, called once on activation.
+	 */
+	virtual void BindEvents(UASComponent* InComponent) {}
+
+	/**
+	 * @brief Unbinds everything bound in BindEvents.
+	 *
+	 * @param InComponent Component of the node or nullptr if it has already been destroyed.
+	 */
+	virtual void UnbindEvents(UASComponent* InComponent) {}
+
+	/**
+	 * @brief Should be called after an output has been triggered, ends the node if it triggers once.
+	 */
+	void OnTriggered();
+
+	FORCEINLINE UASComponent* GetComponent() const { return Component.Get(); }
+	FORCEINLINE bool IsWaiting() const { return bWaiting; }
+
+private:
+	UFUNCTION()
+	void HandleOwnerDestroyed(AActor* InActor);
+
+	TWeakObjectPtr<UASComponent> Component;
+
+	bool bTriggerOnce = true;
+	bool bWaiting = false;
+};
@@ -0,0 +1,84 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ASAsyncAction.h"
+#include "ASAsyncWaitAttributeThreshold.generated.h"
+
+class UAttribute;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FASAsyncAttributeThresholdDelegate, float, Value);
+
+/**
+ * @class UASAsyncWaitAttributeThreshold
+ * @brief Waits until the current value of an attribute satisfies a comparison.
+ *
+ * The attribute may be added to the component after the node has started,
+ * it is picked up when the attribute list changes.
+ */
+UCLASS()
+class ABILITYSYSTEM_API UASAsyncWaitAttributeThreshold : public UASAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Waits until the attribute value satisfies the comparison with the threshold.
+	 *
+	 * @param Component Component owning the attribute.
+	 * @param AttributeClass Class of the attribute to watch.
+	 * @param Comparison How the value is compared with the threshold.
+	 * @param Threshold Threshold value.
+	 * @param bAsPercentOfMax Compare CurrentValue / MaxValue instead of the current value.
+	 * @param bTriggerOnce End the node once the threshold has been reached.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Async", meta=(BlueprintInternalUseOnly="true"))
+	static UASAsyncWaitAttributeThreshold* WaitAttributeThreshold(UASComponent* Component,
+	                                                              TSubclassOf<UAttribute> AttributeClass,
+	                                                              EASAsyncComparison Comparison, float Threshold,
+	                                                              bool bAsPercentOfMax = false,
+	                                                              bool bTriggerOnce = true);
+
+	/**
+	 * @brief Called when the value starts satisfying the comparison (also when it already does on start).
+	 */
+	UPROPERTY(BlueprintAssignable)
+	FASAsyncAttributeThresholdDelegate OnThresholdReached;
+
+	/**
+	 * @brief Called when the value stops satisfying the comparison.
+	 */
+	UPROPERTY(BlueprintAssignable)
+	FASAsyncAttributeThresholdDelegate OnThresholdLeft;
+
+protected:
+	virtual void BindEvents(UASComponent* InComponent) override;
+	virtual void UnbindEvents(UASComponent* InComponent) override;
+
+private:
+	/**
+	 * @brief Binds the attribute currently owned by the component, if it has changed.
+	 *
+	 * @param InRemoving Attribute being removed, treated as missing.
+	 */
+	void BindAttribute(UASComponent* InComponent, UAttribute* InRemoving = nullptr);
+	void UnbindAttribute();
+
+	void Evaluate();
+
+	void HandleAttributeListChanged(UASComponent* InComponent);
+	void HandleAttributeAdded(UASComponent* InComponent, UAttribute* InAttribute);
+	void HandleAttributeRemoved(UASComponent* InComponent, UAttribute* InAttribute);
+	void HandleValueChanged(UAttribute* InAttribute, float InValue);
+
+	TSubclassOf<UAttribute> AttributeClass;
+	TWeakObjectPtr<UAttribute> BoundAttribute;
+
+	EASAsyncComparison Comparison = EASAsyncComparison::Less;
+	float Threshold = 0.0f;
+	bool bAsPercentOfMax = false;
+
+	/** Whether the comparison was satisfied on the last evaluation */
+	bool bReached = false;
+};
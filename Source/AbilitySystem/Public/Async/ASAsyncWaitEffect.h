@@ -0,0 +1,84 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ASAsyncAction.h"
+#include "ASAsyncWaitEffect.generated.h"
+
+class UEffect;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FASAsyncEffectDelegate, UEffect*, Effect);
+
+/**
+ * @class UASAsyncWaitEffect
+ * @brief Waits until an effect of a class is added to or removed from a component.
+ *
+ * Presence of the effect is checked whenever the effect list changes,
+ * so the node works the same way on the server and on clients.
+ */
+UCLASS()
+class ABILITYSYSTEM_API UASAsyncWaitEffect : public UASAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Waits until an effect of the class is added to the component.
+	 *
+	 * @param Component Component to watch.
+	 * @param EffectClass Class of the effect.
+	 * @param bTriggerIfAlreadyPresent Trigger immediately if the component already has the effect.
+	 * @param bTriggerOnce End the node after the first trigger.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Async", meta=(BlueprintInternalUseOnly="true"))
+	static UASAsyncWaitEffect* WaitEffectAdded(UASComponent* Component, TSubclassOf<UEffect> EffectClass,
+	                                           bool bTriggerIfAlreadyPresent = true, bool bTriggerOnce = true);
+
+	/**
+	 * @brief Waits until an effect of the class is removed from the component.
+	 *
+	 * @param Component Component to watch.
+	 * @param EffectClass Class of the effect.
+	 * @param bTriggerIfNotPresent Trigger immediately if the component has no such effect.
+	 * @param bTriggerOnce End the node after the first trigger.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Async", meta=(BlueprintInternalUseOnly="true"))
+	static UASAsyncWaitEffect* WaitEffectRemoved(UASComponent* Component, TSubclassOf<UEffect> EffectClass,
+	                                             bool bTriggerIfNotPresent = true, bool bTriggerOnce = true);
+
+	/**
+	 * @brief Called when the awaited change happens.
+	 *
+	 * The effect is the added one, or the removed one if it has not been destroyed yet.
+	 */
+	UPROPERTY(BlueprintAssignable)
+	FASAsyncEffectDelegate OnChanged;
+
+protected:
+	virtual void BindEvents(UASComponent* InComponent) override;
+	virtual void UnbindEvents(UASComponent* InComponent) override;
+
+private:
+	/**
+	 * @brief Checks the presence of the effect and triggers on the awaited transition.
+	 *
+	 * @param InRemoving Effect being removed, treated as missing.
+	 */
+	void Evaluate(UASComponent* InComponent, UEffect* InRemoving = nullptr);
+
+	void HandleEffectListChanged(UASComponent* InComponent);
+	void HandleEffectAdded(UASComponent* InComponent, UEffect* InEffect);
+	void HandleEffectRemoved(UASComponent* InComponent, UEffect* InEffect);
+
+	TSubclassOf<UEffect> EffectClass;
+
+	/** Last effect of the class seen on the component */
+	TWeakObjectPtr<UEffect> PresentEffect;
+
+	/** Whether the component had an effect of the class on the last check */
+	bool bPresent = false;
+
+	bool bWaitForRemoval = false;
+	bool bTriggerOnStart = true;
+};
@@ -0,0 +1,72 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ASAsyncAction.h"
+#include "ASAsyncWaitStackCount.generated.h"
+
+class UEffect;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FASAsyncStackCountDelegate, UEffect*, Effect, int32, StackCount);
+
+/**
+ * @class UASAsyncWaitStackCount
+ * @brief Waits until the stack count of an effect satisfies a comparison.
+ *
+ * A missing effect counts as zero stacks.
+ */
+UCLASS()
+class ABILITYSYSTEM_API UASAsyncWaitStackCount : public UASAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Waits until the stack count of the effect satisfies the comparison with the count.
+	 *
+	 * @param Component Component to watch.
+	 * @param EffectClass Class of the effect.
+	 * @param Comparison How the stack count is compared with Count.
+	 * @param Count Stack count to compare with.
+	 * @param bTriggerOnce End the node once the count has been reached.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Async", meta=(BlueprintInternalUseOnly="true"))
+	static UASAsyncWaitStackCount* WaitStackCount(UASComponent* Component, TSubclassOf<UEffect> EffectClass,
+	                                              EASAsyncComparison Comparison, int32 Count,
+	                                              bool bTriggerOnce = true);
+
+	/**
+	 * @brief Called when the stack count starts satisfying the comparison (also when it already does on start).
+	 */
+	UPROPERTY(BlueprintAssignable)
+	FASAsyncStackCountDelegate OnCountReached;
+
+	/**
+	 * @brief Called when the stack count stops satisfying the comparison.
+	 */
+	UPROPERTY(BlueprintAssignable)
+	FASAsyncStackCountDelegate OnCountLeft;
+
+protected:
+	virtual void BindEvents(UASComponent* InComponent) override;
+	virtual void UnbindEvents(UASComponent* InComponent) override;
+
+private:
+	/**
+	 * @param InRemoving Effect being removed, treated as missing.
+	 */
+	void Evaluate(UASComponent* InComponent, UEffect* InRemoving = nullptr);
+
+	void HandleEffectListChanged(UASComponent* InComponent);
+	void HandleEffectChanged(UASComponent* InComponent, UEffect* InEffect);
+	void HandleEffectRemoved(UASComponent* InComponent, UEffect* InEffect);
+
+	TSubclassOf<UEffect> EffectClass;
+
+	EASAsyncComparison Comparison = EASAsyncComparison::GreaterOrEqual;
+	int32 Count = 0;
+
+	/** Whether the comparison was satisfied on the last evaluation */
+	bool bReached = false;
+};
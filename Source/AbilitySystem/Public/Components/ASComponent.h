@@ -4,12 +4,55 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Derived/ASDerivedAttributeGraph.h"
+#include "History/ASHistoryBuffer.h"
+#include "Objects/Abilities/Ability.h"
+#include "Objects/Effects/ASEffectContext.h"
+#include "Time/ASEffectClock.h"
+#include "Time/ASEffectScheduler.h"
+#include "UObject/ObjectKey.h"
 #include "ASComponent.generated.h"
 
 
 class UAttribute;
 class UEffect;
 
+/**
+ * @enum EASPendingMutationType
+ * @brief Kind of a list mutation deferred until notifications have finished.
+ */
+enum class EASPendingMutationType : uint8
+{
+	AddEffect,
+	RemoveEffect,
+	RemoveEffectByClass,
+	AddAttribute,
+	RemoveAttribute,
+	RemoveAttributeByClass,
+};
+
+/**
+ * @struct FASPendingMutation
+ * @brief A list mutation issued during a notification of UASComponent.
+ */
+struct FASPendingMutation
+{
+	/** Entity to remove (RemoveEffect, RemoveAttribute) */
+	TWeakObjectPtr<UObject> Entity;
+
+	/** Class to add or remove */
+	TWeakObjectPtr<UClass> Class;
+
+	/** Context of an added effect */
+	TWeakObjectPtr<AActor> Instigator;
+	TWeakObjectPtr<UObject> Source;
+
+	/** Number of mutations in the chain that led to this one */
+	int32 Depth = 0;
+
+	EASPendingMutationType Type = EASPendingMutationType::AddEffect;
+};
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FASComponentDelegate, UASComponent*, Component);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FASComponentAttributeDelegate, UASComponent*, Component, UAttribute*,
@@ -17,6 +60,77 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FASComponentAttributeDelegate, UASC
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FASComponentEffectDelegate, UASComponent*, Component, UEffect*, Entity);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FASComponentAbilityDelegate, UASComponent*, Component, UAbility*,
+                                             Entity);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FASComponentActivationRejectedDelegate, UASComponent*, Component,
+                                             int32, PredictionKey);
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FASComponentNativeEvent, UASComponent*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FASComponentAttributeNativeEvent, UASComponent*, UAttribute*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FASComponentEffectNativeEvent, UASComponent*, UEffect*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FASComponentAbilityNativeEvent, UASComponent*, UAbility*);
+
+/**
+ * @struct FASComponentNativeEvents
+ * @brief Native counterparts of UASComponent delegates, allocated on first use.
+ */
+struct FASComponentNativeEvents
+{
+	FASComponentEffectNativeEvent EffectAdded;
+	FASComponentEffectNativeEvent EffectStacked;
+	FASComponentEffectNativeEvent EffectRemoved;
+	FASComponentEffectNativeEvent EffectStackChanged;
+	FASComponentNativeEvent EffectListUpdated;
+	FASComponentAttributeNativeEvent AttributeAdded;
+	FASComponentAttributeNativeEvent AttributeRemoved;
+	FASComponentNativeEvent AttributeListUpdated;
+	FASComponentAbilityNativeEvent AbilityAdded;
+	FASComponentAbilityNativeEvent AbilityRemoved;
+	FASComponentAbilityNativeEvent AbilityActivated;
+	FASComponentNativeEvent AbilityListUpdated;
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return EffectAdded.GetAllocatedSize() + EffectStacked.GetAllocatedSize() + EffectRemoved.GetAllocatedSize() +
+			EffectStackChanged.GetAllocatedSize() + EffectListUpdated.GetAllocatedSize() + AttributeAdded.GetAllocatedSize() +
+			AttributeRemoved.GetAllocatedSize() + AttributeListUpdated.GetAllocatedSize() +
+			AbilityAdded.GetAllocatedSize() + AbilityRemoved.GetAllocatedSize() +
+			AbilityActivated.GetAllocatedSize() + AbilityListUpdated.GetAllocatedSize();
+	}
+};
+
+/**
+ * @enum EASEffectTimeMode
+ * @brief Defines what drives timers of duration and periodic effects.
+ */
+UENUM(BlueprintType)
+enum class EASEffectTimeMode : uint8
+{
+	/** Effects use world timer manager, ticks follow the frame rate */
+	WorldTimer,
+
+	/** Effects are advanced by the component in fixed simulation steps, results are reproducible */
+	FixedStep,
+
+	/** Effects are advanced by the component every frame, scaled by its effect time scale */
+	ComponentClock,
+};
+
+/**
+ * @enum EASBudgetPolicy
+ * @brief Defines what happens to a new effect when the component is over its budget.
+ */
+UENUM(BlueprintType)
+enum class EASBudgetPolicy : uint8
+{
+	/** New effect is rejected */
+	Reject,
+
+	/** Effects of lower priority than the new one are removed, lowest first. Otherwise the new effect is rejected */
+	EvictLowerPriority,
+};
+
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), DisplayName="Ability System Component (Lightweight)")
 class ABILITYSYSTEM_API UASComponent : public UActorComponent
 {
@@ -33,18 +147,343 @@ protected:
 	UPROPERTY(ReplicatedUsing=OnRep_Attributes)
 	TArray<UAttribute*> Attributes;
 
+	UPROPERTY(ReplicatedUsing=OnRep_Abilities)
+	TArray<UAbility*> Abilities;
+
+	/** Incremented whenever the attribute list changes, lets entities cache attribute lookups */
+	uint32 AttributeListVersion;
+
+	/**
+	 * @brief Attribute values computed from other attributes (server only).
+	 *
+	 * When a source attribute changes only the rules downstream of it are recomputed, in dependency order,
+	 * once per change batch.
+	 *
+	 * @see BeginDerivedAttributeBatch
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Attributes")
+	TArray<FASDerivedAttributeRule> DerivedAttributes;
+
+	/** Dependency graph of DerivedAttributes, built on first use */
+	FASDerivedAttributeGraph DerivedAttributeGraph;
+
+	/** Number of open derived attribute batches, rules are evaluated when it drops to 0 */
+	int32 DerivedAttributeBatchDepth;
+
+	/**
+	 * @brief Maximum length of a chain of mutations caused by notifications (server only).
+	 *
+	 * Effects and attributes added or removed while the component notifies about a change are queued
+	 * and applied after the outer operation. Mutations deeper than this are dropped with a warning.
+	 * Also bounds SetValue calls nested in value listeners.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Cascade", meta=(UIMin="1", ClampMin="1"))
+	int32 MaxCascadeDepth;
+
+	/** Mutations issued during notifications, applied when the outermost notification ends */
+	TArray<FASPendingMutation> PendingMutations;
+
+	/** Number of open notifications, mutations are deferred while it is above 0 */
+	int32 NotificationDepth;
+
+	/** Chain depth of the mutation being applied, 0 for direct calls */
+	int32 CascadeDepth;
+
+	/** PendingMutations are being applied */
+	uint8 bApplyingMutations : 1;
+
+	/** Active effects per instigator (server only) */
+	TMap<FObjectKey, TArray<UEffect*, TInlineAllocator<2>>> EffectsByInstigator;
+
+	/** Instigator key each effect was indexed under, the instigator may be gone by the time the effect is removed */
+	TMap<const UEffect*, FObjectKey> EffectInstigators;
+
+	/** Classes of the effects and attributes added to the world class index, one per entity */
+	TArray<const UClass*> IndexedClasses;
+
+	/**
+	 * @brief Incremented whenever the ability list changes.
+	 *
+	 * Sent back with activation requests, so requests made against an outdated list are rejected
+	 * instead of activating whatever ability has the same index now.
+	 */
+	UPROPERTY(Replicated)
+	uint8 AbilityListRevision;
+
+	/**
+	 * @brief Client: time between sending batches of activation requests, 0 sends once per frame.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Abilities", meta=(UIMin="0", ClampMin="0"))
+	float ActivationFlushInterval;
+
+	/**
+	 * @brief Maximum number of activation requests in a single batch.
+	 *
+	 * Clients keep the rest for the next batch, the server drops anything above it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Abilities", meta=(UIMin="1", ClampMin="1"))
+	int32 MaxActivationsPerBatch;
+
+	/** Client: requests waiting for the next batch */
+	TArray<FASAbilityActivationRequest> PendingActivations;
+
+	/** Client: last generated prediction key, 0 is never used */
+	uint16 LastPredictionKey;
+
+	/** Client: time since the last batch */
+	float ActivationFlushAccumulator;
+
+	/**
+	 * @brief Defines what drives timers of duration and periodic effects.
+	 *
+	 * @note Must be set before effects are added, switching it with active effects is not supported.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Simulation")
+	EASEffectTimeMode EffectTimeMode;
+
+	/**
+	 * @brief Length of a single simulation step in seconds.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Simulation",
+		meta=(UIMin="0.001", ClampMin="0.001", EditCondition="EffectTimeMode==EASEffectTimeMode::FixedStep"))
+	float FixedStepSize;
+
+	/**
+	 * @brief Whether the component advances the simulation from its tick.
+	 *
+	 * Disable to drive the simulation manually via AdvanceSimulation (batch simulation, replays, lockstep).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Simulation",
+		meta=(EditCondition="EffectTimeMode==EASEffectTimeMode::FixedStep"))
+	uint8 bAutoAdvanceSimulation : 1;
+
+	/**
+	 * @brief Maximum number of steps simulated during a single frame. Time beyond that is dropped.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Simulation",
+		meta=(UIMin="1", ClampMin="1", EditCondition="EffectTimeMode==EASEffectTimeMode::FixedStep"))
+	int32 MaxStepsPerFrame;
+
+	/** Timers of effects in FixedStep mode */
+	FASEffectScheduler EffectScheduler;
+
+	/** Number of simulated steps since BeginPlay */
+	int64 SimulationStepCount;
+
+	/** Frame time not yet consumed by simulation steps */
+	float StepAccumulator;
+
+	/**
+	 * @brief Speed of effect timers, e.g. 0.5 slows every effect of the component down twice.
+	 *
+	 * @note Only affects FixedStep and ComponentClock modes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Simulation",
+		meta=(UIMin="0", ClampMin="0", EditCondition="EffectTimeMode!=EASEffectTimeMode::WorldTimer"))
+	float EffectTimeScale;
+
+	/** Effect timers are stopped, see SetEffectsPaused */
+	uint8 bEffectsPaused : 1;
+
+	/** Effect time of the server, for clients */
+	UPROPERTY(ReplicatedUsing=OnRep_EffectClock)
+	FASEffectClock EffectClock;
+
+	/**
+	 * @brief Whether attribute values and effect changes are recorded with server timestamps.
+	 *
+	 * Used for lag compensation, see GetAttributeValueAtTime and HadEffectAtTime.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|History")
+	uint8 bRecordHistory : 1;
+
+	/**
+	 * @brief Maximum number of history records, the oldest ones are overwritten.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|History",
+		meta=(UIMin="1", ClampMin="1", EditCondition="bRecordHistory"))
+	int32 HistoryCapacity;
+
+	/** Recorded changes, allocated on BeginPlay (server only) */
+	FASHistoryBuffer History;
+
+	/**
+	 * @brief Maximum number of active effects, 0 for no limit (server only).
+	 *
+	 * @see BudgetPolicy
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Budget", meta=(UIMin="0", ClampMin="0"))
+	int32 MaxEffects;
+
+	/**
+	 * @brief Maximum estimated memory of the component and its entities in bytes, 0 for no limit (server only).
+	 *
+	 * Checked when an effect is added, see GetResourceSizeEx.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Budget", meta=(UIMin="0", ClampMin="0"))
+	int64 MaxMemoryBytes;
+
+	/**
+	 * @brief What happens to a new effect when MaxEffects or MaxMemoryBytes would be exceeded.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Budget")
+	EASBudgetPolicy BudgetPolicy;
+
+	/**
+	 * @brief Whether the owner is registered in UASSpatialSubsystem and can be found by area queries.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Spatial")
+	uint8 bSpatialIndexed : 1;
+
+	/**
+	 * @brief Maximum time a client waits for all entities of the initial state before notifying anyway.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="AbilitySystem|Replication", meta=(UIMin="0", ClampMin="0"))
+	float InitialStateTimeout;
+
+	/** Client: notifies are held back until the initial state is complete */
+	uint8 bInitialStatePending : 1;
+
+	/** Client: FlushInitialState is scheduled for the next tick */
+	uint8 bInitialStateFlushScheduled : 1;
+
+	/** Client: world time of the first held back notify */
+	double InitialStateStartTime;
+
+	/**
+	 * @brief Number of entities replicated with a NetCondition.
+	 *
+	 * Their entries stay null on connections the condition excludes, so the initial state is complete
+	 * once no more entries than this are null.
+	 */
+	UPROPERTY(Replicated)
+	uint16 ConditionalEntityNum;
+
 protected:
 	UFUNCTION()
-	virtual void OnRep_Effects();
+	virtual void OnRep_Effects(const TArray<UEffect*>& OldEffects);
 
 	UFUNCTION()
 	virtual void OnRep_Attributes();
 
+	UFUNCTION()
+	virtual void OnRep_Abilities();
+
+	UFUNCTION()
+	virtual void OnRep_EffectClock();
+
+	/**
+	 * @brief Activates a batch of abilities requested by the owning client in one pass.
+	 *
+	 * @param InRevision AbilityListRevision the client has seen.
+	 * @param InRequests Requests in the order they were made.
+	 */
+	UFUNCTION(Server, Reliable)
+	void Server_ActivateAbilities(uint8 InRevision, const TArray<FASAbilityActivationRequest>& InRequests);
+
+	/**
+	 * @brief Notifies the owning client about all requests of a batch that have been rejected.
+	 */
+	UFUNCTION(Client, Reliable)
+	void Client_RejectActivations(const TArray<uint16>& InPredictionKeys);
+
 protected:
+	/**
+	 * @brief Simulates a single fixed step.
+	 */
+	virtual void SimulationStep();
+
+	/**
+	 * @brief Replicates the current mapping from server time to effect time.
+	 */
+	void UpdateEffectClock();
+
+	/**
+	 * @brief Gets the server world time, synchronized on clients.
+	 */
+	double GetServerWorldTime() const;
+
+	/**
+	 * @brief Subscribes the component to events of a new attribute.
+	 */
+	virtual void BindAttributeEvents(UAttribute* InAttribute);
+
+	virtual void HandleAttributeValueChanged(UAttribute* InAttribute, float InValue);
+
+	/**
+	 * @brief Builds the derived attribute graph if needed and resolves it against the current attribute list.
+	 *
+	 * @return False if there are no derived attributes.
+	 */
+	bool PrepareDerivedAttributes();
+
+	/**
+	 * @brief Client: notifies the initial state in a single pass once all entities have arrived.
+	 *
+	 * Attributes broadcast their values once, then the list delegates of the component are broadcast once.
+	 */
+	virtual void FlushInitialState();
+
+	/**
+	 * @brief Makes room for a new effect according to the budget.
+	 *
+	 * @param InEffect Effect about to be added.
+	 * @return False if the effect must be rejected.
+	 */
+	virtual bool EnforceEffectBudget(UEffect* InEffect);
+
+	/**
+	 * @brief Queues a mutation if a notification is running.
+	 *
+	 * @return True if the caller must not apply the mutation now (queued or dropped).
+	 */
+	bool DeferMutation(EASPendingMutationType InType, UObject* InEntity, UClass* InClass,
+	                   const FASEffectContext* InContext = nullptr);
+
+	/**
+	 * @brief Adds an entity to the registered subobject list with its net condition (server only).
+	 *
+	 * Iris replicates subobjects from this list only, the legacy replication goes through ReplicateSubobjects.
+	 */
+	void AddReplicatedEntity(UBasicAsEntity* InEntity);
+	void RemoveReplicatedEntity(UBasicAsEntity* InEntity);
+
+	/**
+	 * @brief Adds an effect to the class index of the world and to the instigator indices (server only).
+	 */
+	void IndexEffect(UEffect* InEffect);
+
+	/**
+	 * @brief Removes an effect from the class index of the world and from the instigator indices.
+	 */
+	void UnindexEffect(UEffect* InEffect);
+
+	/**
+	 * @brief Adds an entity class to the class index of the world, once the component has begun play.
+	 */
+	void IndexEntityClass(const UClass* InClass);
+	void UnindexEntityClass(const UClass* InClass);
+
+	/**
+	 * @brief Rebuilds the classes indexed for this component from the current effects and attributes.
+	 */
+	void ReindexEntityClasses();
+	void ClearIndexedEntityClasses();
+
+	/**
+	 * @brief Applies queued mutations, including the ones they queue in turn.
+	 */
+	void ApplyPendingMutations();
+
+	/**
+	 * @brief Adds a record to the history if it is enabled.
+	 */
+	void RecordHistory(const UClass* InClass, EASHistoryRecordType InType, float InValue = 0.0f);
 
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	// Called every frame
@@ -52,12 +491,170 @@ public:
 	                           FActorComponentTickFunction* ThisTickFunction) override;
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 	virtual bool ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 
 public:
 	/* Should be called from effect */
 	void EffectHasEnded(UEffect* InEffect);
 
+	/**
+	 * @brief Called by effects when their stack count has changed (server and clients).
+	 */
+	void NotifyEffectStackChanged(UEffect* InEffect);
+
+	/**
+	 * @brief Checks whether a replication notify is part of the initial state and must be held back.
+	 *
+	 * When a client receives the component for the first time (join, relevancy), every attribute and effect
+	 * would notify separately. Instead, all of them are held back and notified by FlushInitialState in one pass,
+	 * after that the component switches to regular per-entity notifies.
+	 *
+	 * @return True if the caller must skip its notify.
+	 */
+	bool DeferInitialRepNotify();
+
+	/**
+	 * @brief Gets a number that changes every time an attribute is added or removed.
+	 *
+	 * Compare it with a stored value to find out whether cached attribute pointers are still valid.
+	 */
+	FORCEINLINE uint32 GetAttributeListVersion() const { return AttributeListVersion; }
+
+#pragma region Simulation
+	/**
+	 * @brief Advances effects by the given number of fixed steps.
+	 *
+	 * Effects are processed in a deterministic order: by due time, then by the order their timers were started.
+	 *
+	 * @note Only works in FixedStep mode.
+	 *
+	 * @param NumSteps Number of steps to simulate.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Simulation")
+	virtual void AdvanceSimulation(int32 NumSteps = 1);
+
+	/**
+	 * @brief Gets the simulation time in seconds (steps * step size).
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="AbilitySystem|Simulation")
+	double GetSimulationTime() const { return EffectScheduler.GetTime(); }
+
+	/**
+	 * @brief Checks whether effect timers are driven by this component instead of the world timer manager.
+	 */
+	FORCEINLINE bool UsesEffectScheduler() const { return EffectTimeMode != EASEffectTimeMode::WorldTimer; }
+
+	FORCEINLINE FASEffectScheduler& GetEffectScheduler() { return EffectScheduler; }
+	FORCEINLINE const FASEffectScheduler& GetEffectScheduler() const { return EffectScheduler; }
+
+	/**
+	 * @brief Sets the speed of all effect timers of the component at once.
+	 *
+	 * Timers are expressed in effect time, so their callbacks move without touching any of them.
+	 *
+	 * @note Only affects FixedStep and ComponentClock modes.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Simulation")
+	void SetEffectTimeScale(float InTimeScale);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="AbilitySystem|Simulation")
+	FORCEINLINE float GetEffectTimeScale() const { return EffectTimeScale; }
+
+	/**
+	 * @brief Stops or resumes all effect timers of the component at once, e.g. for a time stop.
+	 *
+	 * @note Only affects FixedStep and ComponentClock modes.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Simulation")
+	void SetEffectsPaused(bool bInPaused);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="AbilitySystem|Simulation")
+	FORCEINLINE bool AreEffectsPaused() const { return bEffectsPaused; }
+
+	/**
+	 * @brief Gets the time effect timings are expressed in (server and clients).
+	 *
+	 * Scheduler time when effects use the scheduler, otherwise the server world time.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="AbilitySystem|Simulation")
+	double GetEffectTime() const;
+
+	/**
+	 * @brief Gets effect seconds per world second, 0 while paused, 1 when effects use the world timer manager.
+	 */
+	FORCEINLINE float GetEffectTimeRate() const { return UsesEffectScheduler() ? EffectClock.Rate : 1.0f; }
+#pragma endregion Simulation
+
+#pragma region History
+	/**
+	 * @brief Gets the current value an attribute had at the given server time.
+	 *
+	 * Walks the history ring buffer, does not allocate.
+	 *
+	 * @note Requires bRecordHistory, server only. Attributes are matched by exact class.
+	 *
+	 * @param AttributeClass Class of the attribute.
+	 * @param ServerTime Server world time (UWorld::GetTimeSeconds).
+	 * @param OutValue Current value of the attribute at that time.
+	 * @return False if the attribute did not exist at that time or the time is beyond the recorded history.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|History")
+	virtual bool GetAttributeValueAtTime(TSubclassOf<UAttribute> AttributeClass, double ServerTime,
+	                                     float& OutValue) const;
+
+	/**
+	 * @brief Checks whether an effect was active at the given server time.
+	 *
+	 * Walks the history ring buffer, does not allocate.
+	 *
+	 * @note Requires bRecordHistory, server only. Effects are matched by exact class.
+	 * Times older than GetHistoryStartTime are answered with the oldest known state until the history wraps.
+	 *
+	 * @param EffectClass Class of the effect.
+	 * @param ServerTime Server world time (UWorld::GetTimeSeconds).
+	 * @return True if the effect was active at that time, false if it was not or the time is beyond the recorded history.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|History")
+	virtual bool HadEffectAtTime(TSubclassOf<UEffect> EffectClass, double ServerTime) const;
+
+	/**
+	 * @brief Gets the time of the oldest history record.
+	 *
+	 * @return Server time of the oldest record, current time if nothing is recorded.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="AbilitySystem|History")
+	double GetHistoryStartTime() const;
+#pragma endregion History
+
+#pragma region Snapshot
+	/**
+	 * @brief Writes the state of the component into a compact versioned binary snapshot.
+	 *
+	 * Stores attributes (min, max and current values), active effects with their stack count,
+	 * remaining time and period phase, and abilities with their remaining cooldown.
+	 *
+	 * @param OutData Snapshot data.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Snapshot")
+	virtual void SaveSnapshot(TArray<uint8>& OutData) const;
+
+	/**
+	 * @brief Replaces the state of the component with a snapshot.
+	 *
+	 * Current entities are dropped without per-entity notifications, restored effects continue
+	 * via `UEffect::ResumeWork()` instead of `StartWork()`. Listeners are notified once with
+	 * list updates after everything is restored.
+	 *
+	 * @note Entries of classes that no longer exist or are not loaded are skipped, restoring never loads assets.
+	 *
+	 * @param InData Snapshot data created by SaveSnapshot.
+	 * @return True if the snapshot was restored, false if the data is invalid (state is left unchanged).
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Snapshot")
+	virtual bool RestoreSnapshot(const TArray<uint8>& InData);
+#pragma endregion Snapshot
+
 public:
 #pragma region Effects
 	/**
@@ -91,10 +688,12 @@ public:
 	 * the stack operation is performed, otherwise the new effect is discarded.
 	 *
 	 * @param EffectClass The class type of the effect to add.
+	 * @param Context Instigator and source of the effect, a stacked effect keeps its original context.
 	 * @return Effect instance if created successfully
 	 */
-	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects")
-	virtual UEffect* AddEffect(TSubclassOf<UEffect> EffectClass);
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects",
+		meta=(AutoCreateRefTerm="Context"))
+	virtual UEffect* AddEffect(TSubclassOf<UEffect> EffectClass, const FASEffectContext& Context = FASEffectContext());
 
 	/**
 	 * @brief Retrieves an active effect from the component's effect list by its class type.
@@ -144,6 +743,36 @@ public:
 	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Effects")
 	virtual void GetEffectList(TArray<UEffect*>& OutEffects);
 
+	/**
+	 * @brief Gets active effects of this component applied by an instigator (server only).
+	 *
+	 * @see UASIndexSubsystem for effects of an instigator across the world.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects")
+	void GetEffectsByInstigator(AActor* Instigator, TArray<UEffect*>& OutEffects) const;
+
+	/**
+	 * @brief Counts active effects of this component applied by an instigator (server only).
+	 *
+	 * @param Instigator Instigator of the effects.
+	 * @param EffectClass Only effects of this class are counted, all if None.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects")
+	int32 CountEffectsByInstigator(AActor* Instigator, TSubclassOf<UEffect> EffectClass = nullptr) const;
+
+	/**
+	 * @brief Removes active effects of this component applied by an instigator.
+	 *
+	 * @note Removals requested while the component notifies are applied afterwards (see MaxCascadeDepth)
+	 * and are not counted, neither are effects removed by the cascade of another removal.
+	 *
+	 * @param Instigator Instigator of the effects.
+	 * @param EffectClass Only effects of this class are removed, all if None.
+	 * @return Number of effects removed by this call.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects")
+	int32 RemoveEffectsByInstigator(AActor* Instigator, TSubclassOf<UEffect> EffectClass = nullptr);
+
 #pragma endregion Effects
 
 #pragma region Attributes
@@ -225,8 +854,141 @@ public:
 	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Attribute")
 	virtual void GetAttributeList(TArray<UAttribute*>& OutAttributes);
 
+	/**
+	 * @brief Opens a batch of attribute changes, derived attributes are not recomputed until it is closed.
+	 *
+	 * Batches can be nested.
+	 */
+	void BeginDerivedAttributeBatch();
+
+	/**
+	 * @brief Closes a batch opened with BeginDerivedAttributeBatch and recomputes affected derived attributes.
+	 */
+	void EndDerivedAttributeBatch();
+
+	/**
+	 * @brief Recomputes derived attributes affected by changes so far, unless a batch is open.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Attributes")
+	virtual void UpdateDerivedAttributes();
+
+	/**
+	 * @brief Opens a notification, effects and attributes added or removed until it is closed are queued.
+	 *
+	 * Notifications can be nested.
+	 */
+	void BeginNotification();
+
+	/**
+	 * @brief Closes a notification opened with BeginNotification, the outermost one applies queued mutations.
+	 */
+	void EndNotification();
+
+	FORCEINLINE bool IsNotifying() const { return NotificationDepth > 0; }
+	FORCEINLINE int32 GetMaxCascadeDepth() const { return MaxCascadeDepth; }
+	FORCEINLINE int32 GetNumPendingMutations() const { return PendingMutations.Num(); }
+
 #pragma endregion Attributes
 
+#pragma region Abilities
+	/**
+	 * @brief Adds a new ability of the specified class.
+	 *
+	 * @param AbilityClass The class of the ability to add.
+	 * @return A pointer to the newly added ability, nullptr if an ability of that class already exists.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Abilities")
+	virtual UAbility* AddAbility(TSubclassOf<UAbility> AbilityClass);
+
+	/**
+	 * @brief Removes an ability by its entity.
+	 *
+	 * @param InAbility The ability to be removed.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Abilities")
+	virtual void RemoveAbilityByEntity(UAbility* InAbility);
+
+	/**
+	 * @brief Removes the first ability of the specified class.
+	 *
+	 * @param AbilityClass The class of the ability to remove.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Abilities")
+	virtual void RemoveAbilityByClass(TSubclassOf<UAbility> AbilityClass);
+
+	/**
+	 * @brief Retrieves an ability of the specified class.
+	 *
+	 * @param AbilityClass The class of the ability to retrieve.
+	 * @return A reference to the found ability, if any.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Abilities", Meta=(DeterminesOutputType="AbilityClass"))
+	virtual UAbility* GetAbility(TSubclassOf<UAbility> AbilityClass);
+
+	/**
+	 * @brief Gets the ability of the specified class.
+	 *
+	 * @param AbilityClass The class of the ability to retrieve.
+	 * @return A pointer to the ability of the specified class.
+	 */
+	virtual UAbility* Ability(TSubclassOf<UAbility> AbilityClass) const;
+
+	/**
+	 * @brief Checks if an ability of the specified class exists.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Abilities")
+	virtual bool HasAbility(TSubclassOf<UAbility> AbilityClass) const;
+
+	/**
+	 * @brief Checks whether the ability of the specified class exists, is ready and can be paid for.
+	 *
+	 * Works on server and clients using replicated cooldowns and attribute values.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="AbilitySystem|Abilities")
+	virtual bool CanActivateAbility(TSubclassOf<UAbility> AbilityClass) const;
+
+	/**
+	 * @brief Activates the ability of the specified class if it can be activated.
+	 *
+	 * @param AbilityClass The class of the ability to activate.
+	 * @return True if the ability has been activated.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Abilities")
+	virtual bool TryActivateAbility(TSubclassOf<UAbility> AbilityClass);
+
+	/**
+	 * @brief Requests activation of an ability from the owning client.
+	 *
+	 * Requests are not sent right away: all requests made since the previous batch are sent in a single
+	 * reliable RPC (see ActivationFlushInterval) and processed by the server in one pass.
+	 * On the server the ability is activated immediately and 0 is returned, use TryActivateAbility
+	 * to know the result.
+	 *
+	 * @note The owner of the component must be owned by the client connection.
+	 *
+	 * @param AbilityClass The class of the ability to activate.
+	 * @return Prediction key of the request (passed to OnAbilityActivationRejected), 0 if the ability
+	 * can not be activated right now.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Abilities")
+	virtual int32 RequestActivateAbility(TSubclassOf<UAbility> AbilityClass);
+
+	/**
+	 * @brief Client: sends all pending activation requests now.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Abilities")
+	virtual void FlushActivationRequests();
+
+	/**
+	 * @brief Retrieves the list of all abilities in the component.
+	 *
+	 * @param OutAbilities An array to be filled with the abilities.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Abilities")
+	virtual void GetAbilityList(TArray<UAbility*>& OutAbilities);
+
+#pragma endregion Abilities
+
 #pragma region Events
 
 	/**
@@ -241,6 +1003,12 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="AbilitySystem|Effects")
 	FASComponentEffectDelegate OnEffectStacked;
 
+	/**
+	 * @brief Delegate called when the stack count of an effect has changed (server and clients).
+	 */
+	UPROPERTY(BlueprintAssignable, Category="AbilitySystem|Effects")
+	FASComponentEffectDelegate OnEffectStackChanged;
+
 	/**
 	 * @brief Delegate called when an effect is removed.
 	 */
@@ -271,5 +1039,65 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="AbilitySystem|Attributes")
 	FASComponentDelegate OnAttributeListUpdated;
 
+	/**
+	 * @brief Delegate called when an ability is added.
+	 */
+	UPROPERTY(BlueprintAssignable, Category="AbilitySystem|Abilities")
+	FASComponentAbilityDelegate OnAbilityAdded;
+
+	/**
+	 * @brief Delegate called when an ability is removed.
+	 */
+	UPROPERTY(BlueprintAssignable, Category="AbilitySystem|Abilities")
+	FASComponentAbilityDelegate OnAbilityRemoved;
+
+	/**
+	 * @brief Delegate called on the server when an ability is activated.
+	 */
+	UPROPERTY(BlueprintAssignable, Category="AbilitySystem|Abilities")
+	FASComponentAbilityDelegate OnAbilityActivated;
+
+	/**
+	 * @brief Delegate called when the ability list is updated.
+	 */
+	UPROPERTY(BlueprintAssignable, Category="AbilitySystem|Abilities")
+	FASComponentDelegate OnAbilityListUpdated;
+
+	/**
+	 * @brief Delegate called on the owning client when the server has rejected an activation request.
+	 */
+	UPROPERTY(BlueprintAssignable, Category="AbilitySystem|Abilities")
+	FASComponentActivationRejectedDelegate OnAbilityActivationRejected;
+
+	/**
+	 * @brief Gets native events of the component, allocating them on first use.
+	 *
+	 * Native events are cheaper than the Blueprint delegates above and cost no memory until something binds.
+	 */
+	FASComponentNativeEvents& GetNativeEvents();
+
+	FORCEINLINE bool HasNativeEvents() const { return NativeEvents.IsValid(); }
+
 #pragma endregion Events
+
+protected:
+	/**
+	 * @brief Broadcasts a Blueprint delegate and its native counterpart, skipping the ones without listeners.
+	 */
+	template <typename TDelegate, typename TNativeEvent, typename... TArgs>
+	FORCEINLINE void BroadcastEvent(TDelegate& InDelegate, TNativeEvent FASComponentNativeEvents::*InNativeEvent,
+	                                TArgs... InArgs)
+	{
+		if (InDelegate.IsBound())
+		{
+			InDelegate.Broadcast(InArgs...);
+		}
+		if (NativeEvents.IsValid())
+		{
+			(NativeEvents.Get()->*InNativeEvent).Broadcast(InArgs...);
+		}
+	}
+
+private:
+	TUniquePtr<FASComponentNativeEvents> NativeEvents;
 };
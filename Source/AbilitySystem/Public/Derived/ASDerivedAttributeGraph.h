@@ -0,0 +1,155 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ASDerivedAttributeGraph.generated.h"
+
+class UAttribute;
+class UASComponent;
+
+/**
+ * @enum EASDerivedAttributeField
+ * @brief Value of the target attribute written by a derived attribute rule.
+ */
+UENUM(BlueprintType)
+enum class EASDerivedAttributeField : uint8
+{
+	CurrentValue,
+	MaxValue,
+	MinValue,
+};
+
+/**
+ * @struct FASDerivedAttributeSource
+ * @brief Attribute read by a derived attribute rule.
+ */
+USTRUCT(BlueprintType)
+struct ABILITYSYSTEM_API FASDerivedAttributeSource
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Attribute whose current value is read.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="DerivedAttribute")
+	TSubclassOf<UAttribute> Attribute;
+
+	/**
+	 * @brief Multiplier of the current value.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="DerivedAttribute")
+	float Coefficient = 1.0f;
+};
+
+/**
+ * @struct FASDerivedAttributeRule
+ * @brief Declares a value of an attribute computed from other attributes.
+ *
+ * Target.Field = BaseValue + Sum(Source.CurrentValue * Source.Coefficient)
+ *
+ * @note Example: MaxValue of MaxHealth = 100 + Vitality * 10
+ */
+USTRUCT(BlueprintType)
+struct ABILITYSYSTEM_API FASDerivedAttributeRule
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Attribute to write.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="DerivedAttribute")
+	TSubclassOf<UAttribute> Target;
+
+	/**
+	 * @brief Value of the target to write.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="DerivedAttribute")
+	EASDerivedAttributeField Field = EASDerivedAttributeField::CurrentValue;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="DerivedAttribute")
+	float BaseValue = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="DerivedAttribute")
+	TArray<FASDerivedAttributeSource> Sources;
+};
+
+/**
+ * @class FASDerivedAttributeGraph
+ * @brief Dependency graph of derived attribute rules of a component.
+ *
+ * The graph is built once from the rules: rules are sorted topologically, so a rule is always
+ * evaluated after the rules writing its sources. Rules forming a cycle are dropped.
+ *
+ * At runtime a changed source only marks the rules reading it. Evaluate walks the marked rules
+ * in topological order, each rule is computed at most once per call. A rule writes its target
+ * only if the value has changed, which in turn marks the rules downstream.
+ */
+class ABILITYSYSTEM_API FASDerivedAttributeGraph
+{
+public:
+	/**
+	 * @brief Builds the graph from rules.
+	 */
+	void Build(const TArray<FASDerivedAttributeRule>& InRules, const UObject* InContext = nullptr);
+
+	/**
+	 * @brief Resolves attributes of the component, all rules are marked.
+	 */
+	void Resolve(const UASComponent* InComponent);
+
+	/**
+	 * @brief Marks the rules reading the attribute.
+	 */
+	void MarkChanged(const UAttribute* InAttribute);
+
+	/**
+	 * @brief Computes marked rules in topological order and writes their targets.
+	 *
+	 * @return Number of computed rules.
+	 */
+	int32 Evaluate();
+
+	FORCEINLINE bool IsBuilt() const { return bBuilt; }
+	FORCEINLINE bool IsEmpty() const { return Nodes.Num() == 0; }
+	FORCEINLINE bool HasDirtyNodes() const { return NumDirty > 0; }
+	FORCEINLINE uint32 GetResolvedVersion() const { return ResolvedVersion; }
+
+	/**
+	 * @brief Checks whether any rule reads an attribute of the class.
+	 */
+	bool IsSource(const UClass* InClass) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FSource
+	{
+		const UClass* Class = nullptr;
+		float Coefficient = 1.0f;
+		UAttribute* Attribute = nullptr;
+	};
+
+	struct FNode
+	{
+		const UClass* TargetClass = nullptr;
+		EASDerivedAttributeField Field = EASDerivedAttributeField::CurrentValue;
+		float BaseValue = 0.0f;
+		TArray<FSource, TInlineAllocator<2>> Sources;
+		UAttribute* Target = nullptr;
+	};
+
+	/** Rules in topological order */
+	TArray<FNode> Nodes;
+
+	/** Node indices reading an attribute */
+	TMap<const UAttribute*, TArray<int32, TInlineAllocator<2>>> Readers;
+
+	TBitArray<> Dirty;
+	int32 NumDirty = 0;
+
+	/** UASComponent::GetAttributeListVersion attributes were resolved for */
+	uint32 ResolvedVersion = 0;
+
+	bool bBuilt = false;
+};
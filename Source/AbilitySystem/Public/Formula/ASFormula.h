@@ -0,0 +1,164 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ASFormula.generated.h"
+
+class UAttribute;
+
+/**
+ * @struct FASFormulaContext
+ * @brief Inputs of a formula evaluation.
+ */
+struct FASFormulaContext
+{
+	/** Attributes in the order of FASFormula::Attributes, null entries read as 0 */
+	TArrayView<const UAttribute* const> Attributes;
+
+	float Stacks = 1.0f;
+	float Level = 1.0f;
+};
+
+/**
+ * @class FASFormulaProgram
+ * @brief Flat bytecode of a compiled formula, evaluated on a small value stack.
+ *
+ * Programs are immutable and shared by every copy of the formula, evaluation is thread-safe.
+ */
+class ABILITYSYSTEM_API FASFormulaProgram
+{
+public:
+	enum class EOp : uint8
+	{
+		Constant,
+		Attribute,
+		Stacks,
+		Level,
+		Negate,
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Power,
+		Min,
+		Max,
+		Abs,
+		Clamp,
+		Floor,
+		Ceil,
+		Sqrt,
+	};
+
+	struct FInstruction
+	{
+		EOp Op = EOp::Constant;
+
+		/** Index of the constant or attribute slot */
+		uint16 Operand = 0;
+	};
+
+	/**
+	 * @brief Compiles an expression.
+	 *
+	 * @param InExpression Expression, e.g. "10 + Strength * 0.5 * Stacks".
+	 * @param InAttributeNames Names of attribute slots usable in the expression.
+	 * @param OutError Description of the first error, if any.
+	 * @return Compiled program or nullptr if the expression is invalid.
+	 */
+	static TSharedPtr<const FASFormulaProgram> Compile(const FString& InExpression,
+	                                                   TArrayView<const FName> InAttributeNames, FString& OutError);
+
+	float Execute(const FASFormulaContext& InContext) const;
+
+	/**
+	 * @brief Checks whether the program reads attributes.
+	 */
+	FORCEINLINE bool ReadsAttributes() const { return bReadsAttributes; }
+
+private:
+	friend class FASFormulaCompiler;
+
+	TArray<FInstruction> Instructions;
+	TArray<float> Constants;
+	int32 MaxStackSize = 0;
+	bool bReadsAttributes = false;
+};
+
+/**
+ * @struct FASFormulaAttribute
+ * @brief Names an attribute for use in a formula.
+ */
+USTRUCT(BlueprintType)
+struct ABILITYSYSTEM_API FASFormulaAttribute
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Name used in the expression.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Formula")
+	FName Name;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Formula")
+	TSubclassOf<UAttribute> Attribute;
+};
+
+/**
+ * @struct FASFormula
+ * @brief Small arithmetic expression evaluated natively, without the Blueprint VM.
+ *
+ * Supports numbers, `+ - * / ^`, parentheses, `Stacks`, `Level`, attributes by their name
+ * (current value) and functions `min, max, abs, clamp, floor, ceil, sqrt`.
+ *
+ * The expression is compiled once, copies of the formula (e.g. effect instances created from
+ * their class defaults) share the compiled program.
+ */
+USTRUCT(BlueprintType)
+struct ABILITYSYSTEM_API FASFormula
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Expression, e.g. "10 + Strength * 0.5 * Stacks".
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Formula")
+	FString Expression;
+
+	/**
+	 * @brief Attributes usable in the expression.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Formula")
+	TArray<FASFormulaAttribute> Attributes;
+
+	/**
+	 * @brief Compiles the expression, errors are logged.
+	 *
+	 * @param InContext Object used in error messages.
+	 * @return True if the expression is valid.
+	 */
+	bool Compile(const UObject* InContext = nullptr);
+
+	/**
+	 * @brief Compiles the expression if it has not been compiled yet.
+	 */
+	FORCEINLINE bool EnsureCompiled(const UObject* InContext = nullptr)
+	{
+		return Program.IsValid() || (!bCompileFailed && !Expression.IsEmpty() && Compile(InContext));
+	}
+
+	FORCEINLINE bool IsEmpty() const { return Expression.IsEmpty(); }
+	FORCEINLINE bool IsCompiled() const { return Program.IsValid(); }
+
+	/**
+	 * @return Result of the formula, 0 if it is not compiled.
+	 */
+	FORCEINLINE float Evaluate(const FASFormulaContext& InContext) const
+	{
+		return Program.IsValid() ? Program->Execute(InContext) : 0.0f;
+	}
+
+private:
+	TSharedPtr<const FASFormulaProgram> Program;
+	bool bCompileFailed = false;
+};
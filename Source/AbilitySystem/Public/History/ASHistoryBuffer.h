@@ -0,0 +1,107 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @enum EASHistoryRecordType
+ * @brief Kind of change stored in FASHistoryRecord.
+ */
+enum class EASHistoryRecordType : uint8
+{
+	/** Current value of an attribute has changed */
+	AttributeValue,
+
+	/** Effect has been added */
+	EffectAdded,
+
+	/** Effect has been removed */
+	EffectRemoved,
+};
+
+/**
+ * @struct FASHistoryRecord
+ * @brief A single timestamped change of the component state.
+ */
+struct FASHistoryRecord
+{
+	/** Server world time of the change */
+	double Time = 0.0;
+
+	/** Class of the changed attribute or effect */
+	const UClass* Class = nullptr;
+
+	/** New current value (attributes only) */
+	float Value = 0.0f;
+
+	EASHistoryRecordType Type = EASHistoryRecordType::AttributeValue;
+};
+
+/**
+ * @class FASHistoryBuffer
+ * @brief Fixed-capacity ring buffer of FASHistoryRecord.
+ *
+ * Memory is allocated once in Init(), adding records and reading them never allocates.
+ * When the buffer is full the oldest record is overwritten.
+ */
+class ABILITYSYSTEM_API FASHistoryBuffer
+{
+public:
+	/**
+	 * @brief Allocates the buffer and drops all records.
+	 */
+	void Init(int32 InCapacity);
+
+	/**
+	 * @brief Drops all records, keeps the memory.
+	 */
+	void Reset();
+
+	void Add(const FASHistoryRecord& InRecord);
+
+	/**
+	 * @brief Gets a record by age.
+	 *
+	 * @param InIndex 0 is the newest record, Num() - 1 is the oldest one.
+	 */
+	FORCEINLINE const FASHistoryRecord& GetFromNewest(int32 InIndex) const
+	{
+		check(InIndex >= 0 && InIndex < Count);
+		int32 index = Head - 1 - InIndex;
+		if (index < 0)
+		{
+			index += Records.Num();
+		}
+		return Records[index];
+	}
+
+	FORCEINLINE int32 Num() const { return Count; }
+	FORCEINLINE int32 GetCapacity() const { return Records.Num(); }
+	FORCEINLINE bool IsEnabled() const { return Records.Num() > 0; }
+
+	/**
+	 * @brief Checks whether older records have been overwritten.
+	 */
+	FORCEINLINE bool HasWrapped() const { return bWrapped; }
+
+	/**
+	 * @brief Checks whether the state at a time can be reconstructed from the records.
+	 *
+	 * @return False if records at or before that time may have been overwritten.
+	 */
+	bool Covers(double InTime) const;
+
+	SIZE_T GetAllocatedSize() const { return Records.GetAllocatedSize(); }
+
+private:
+	TArray<FASHistoryRecord> Records;
+
+	/** Index of the next record to write */
+	int32 Head = 0;
+
+	/** Number of valid records */
+	int32 Count = 0;
+
+	bool bWrapped = false;
+};
@@ -0,0 +1,160 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * @enum EASJournalRecordType
+ * @brief Kind of event stored in FASJournalRecord.
+ */
+enum class EASJournalRecordType : uint8
+{
+	/** Effect has been added, value is its stack count */
+	EffectAdded,
+
+	/** Stack count of an effect has changed, value is the new count */
+	EffectStackChanged,
+
+	/** Effect has been removed */
+	EffectRemoved,
+
+	/** Attribute has been added, value is its current value */
+	AttributeAdded,
+
+	/** Attribute has been removed */
+	AttributeRemoved,
+
+	/** Current value of an attribute has been set, value is the clamped value */
+	AttributeValue,
+};
+
+/**
+ * @struct FASJournalRecord
+ * @brief A single journal event, fixed-size so records can be copied and written as raw memory.
+ *
+ * Actors and classes are referenced by ids of the journal name table.
+ */
+struct FASJournalRecord
+{
+	/** World time of the event */
+	double Time = 0.0;
+
+	uint32 ActorId = 0;
+	uint32 ClassId = 0;
+	float Value = 0.0f;
+
+	EASJournalRecordType Type = EASJournalRecordType::EffectAdded;
+	uint8 Padding[3] = {};
+};
+
+static_assert(sizeof(FASJournalRecord) == 24, "Journal records are written as raw memory, keep the layout fixed");
+
+/**
+ * @enum EASJournalNameKind
+ * @brief What an entry of the journal name table names.
+ */
+enum class EASJournalNameKind : uint8
+{
+	Actor,
+	Class,
+};
+
+/**
+ * @struct FASJournalName
+ * @brief Entry of the journal name table.
+ */
+struct FASJournalName
+{
+	FString Name;
+	uint32 Id = 0;
+	EASJournalNameKind Kind = EASJournalNameKind::Actor;
+};
+
+/**
+ * @class FASJournalRingBuffer
+ * @brief Lock-free single producer / single consumer ring buffer of journal records.
+ *
+ * The game thread pushes records, the flush task pops them. Memory is allocated once in Init().
+ * When the buffer is full new records are rejected instead of overwriting unread ones.
+ */
+class ABILITYSYSTEM_API FASJournalRingBuffer
+{
+public:
+	/**
+	 * @brief Allocates the buffer, the capacity is rounded up to a power of two.
+	 *
+	 * @note Must not be called while the buffer is used by another thread.
+	 */
+	void Init(uint32 InCapacity);
+
+	/**
+	 * @brief Adds a record (producer thread only).
+	 *
+	 * @return False if the buffer is full.
+	 */
+	FORCEINLINE bool Push(const FASJournalRecord& InRecord)
+	{
+		const uint32 head = Head.load(std::memory_order_relaxed);
+		if (head - Tail.load(std::memory_order_acquire) >= Capacity)
+			return false;
+
+		Records[head & Mask] = InRecord;
+		Head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Moves all available records to the array (consumer thread only).
+	 *
+	 * @return Number of records appended.
+	 */
+	int32 Pop(TArray<FASJournalRecord>& OutRecords);
+
+	/**
+	 * @brief Approximate number of unread records, safe to call from any thread.
+	 */
+	FORCEINLINE uint32 Num() const
+	{
+		return Head.load(std::memory_order_relaxed) - Tail.load(std::memory_order_relaxed);
+	}
+
+	FORCEINLINE uint32 GetCapacity() const { return Capacity; }
+
+	SIZE_T GetAllocatedSize() const { return Records.GetAllocatedSize(); }
+
+private:
+	TArray<FASJournalRecord> Records;
+	uint32 Capacity = 0;
+	uint32 Mask = 0;
+
+	/** Written by the producer only */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Head{0};
+
+	/** Written by the consumer only */
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Tail{0};
+};
+
+namespace ASJournal
+{
+	/** Magic number at the start of every journal file */
+	static constexpr uint32 Magic = 0x524A5341; // 'ASJR'
+
+	/** Version of the journal file format */
+	static constexpr uint16 Version = 1;
+
+	/**
+	 * @enum EChunk
+	 * @brief Chunks following the journal header.
+	 */
+	enum class EChunk : uint8
+	{
+		/** Packed count followed by FASJournalName entries */
+		Names,
+
+		/** Packed count followed by raw FASJournalRecord memory */
+		Records,
+	};
+}
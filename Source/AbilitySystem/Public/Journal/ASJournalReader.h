@@ -0,0 +1,62 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Journal/ASJournal.h"
+
+/**
+ * @class FASJournalReader
+ * @brief Offline reader of journal files written by UASJournalSubsystem.
+ */
+class ABILITYSYSTEM_API FASJournalReader
+{
+public:
+	/**
+	 * @brief Reads a whole journal file.
+	 *
+	 * @return False if the file can't be read or is not a journal. Records of a truncated file are kept.
+	 */
+	bool Load(const FString& InFilePath);
+
+	FORCEINLINE const TArray<FASJournalRecord>& GetRecords() const { return Records; }
+
+	/**
+	 * @brief Gets the UTC time the journal has been started at.
+	 */
+	FORCEINLINE const FDateTime& GetStartTime() const { return StartTime; }
+
+	/**
+	 * @brief Gets the path name of a journaled actor.
+	 */
+	FString GetActorName(uint32 InId) const;
+
+	/**
+	 * @brief Gets the path name of a journaled class.
+	 */
+	FString GetClassName(uint32 InId) const;
+
+	/**
+	 * @brief Gets records of one actor in the order they happened.
+	 *
+	 * @param InActor Name or path name of the actor, empty to get all records.
+	 */
+	void GetTimeline(const FString& InActor, TArray<FASJournalRecord>& OutRecords) const;
+
+	/**
+	 * @brief Prints the timeline of one actor, one event per line.
+	 *
+	 * @param InActor Name or path name of the actor, empty to print all records.
+	 */
+	void PrintTimeline(FOutputDevice& Ar, const FString& InActor) const;
+
+	static const TCHAR* LexToString(EASJournalRecordType InType);
+
+private:
+	bool MatchesActor(uint32 InId, const FString& InActor) const;
+
+	TMap<uint32, FString> ActorNames;
+	TMap<uint32, FString> ClassNames;
+	TArray<FASJournalRecord> Records;
+	FDateTime StartTime;
+};
@@ -0,0 +1,123 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Journal/ASJournal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+#include "ASJournalSubsystem.generated.h"
+
+/**
+ * @class UASJournalSubsystem
+ * @brief Optional per-world journal of effect and attribute events for replay debugging.
+ *
+ * Events are stored as FASJournalRecord in a lock-free ring buffer on the game thread and
+ * written to a local file by a background task every 'as.Journal.FlushInterval' seconds.
+ * Names of actors and classes are written once, records reference them by id.
+ *
+ * @note Recording starts for every new world with 'as.Journal.Enabled 1', or on demand with 'as.Journal.Start'.
+ * @note Journals are read offline with FASJournalReader or 'as.Journal.Replay <File> [Actor]'.
+ */
+UCLASS()
+class ABILITYSYSTEM_API UASJournalSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	/**
+	 * @brief Starts writing a new journal file, stops the current one first.
+	 *
+	 * @param InFilePath Target file, relative paths are placed in Saved/AbilitySystem/Journal.
+	 *                   Empty path generates a name from the world and the current time.
+	 * @return True if the file has been opened.
+	 */
+	bool Start(const FString& InFilePath = FString());
+
+	/**
+	 * @brief Writes all pending records and closes the file.
+	 */
+	void Stop();
+
+	FORCEINLINE bool IsRecording() const { return Writer.IsValid(); }
+	FORCEINLINE const FString& GetFilePath() const { return FilePath; }
+
+	/**
+	 * @brief Checks whether any world is recording, cheap enough to call before every event.
+	 */
+	static FORCEINLINE bool IsAnyRecording() { return NumRecording > 0; }
+
+	/**
+	 * @brief Records an event into the journal of the actor's world, if it is recording.
+	 *
+	 * @param InActor Actor owning the component of the entity.
+	 * @param InType Kind of the event.
+	 * @param InClass Class of the effect or attribute.
+	 * @param InValue Event value, see EASJournalRecordType.
+	 */
+	static void RecordEvent(const AActor* InActor, EASJournalRecordType InType, const UClass* InClass,
+	                        float InValue = 0.0f);
+
+	/**
+	 * @brief Records an event (game thread only).
+	 */
+	void Record(const AActor* InActor, EASJournalRecordType InType, const UClass* InClass, float InValue);
+
+private:
+	uint32 FindOrAddName(TMap<FObjectKey, uint32>& InIds, const UObject* InObject, EASJournalNameKind InKind);
+
+	/**
+	 * @brief Launches the background write of pending records, unless one is already running.
+	 */
+	void LaunchFlush();
+
+	/**
+	 * @brief Writes pending names and records to the file (one thread at a time).
+	 */
+	void WritePending();
+
+	static int32 NumRecording;
+
+	FASJournalRingBuffer Ring;
+
+	/** Names queued on the game thread, written by the flush task */
+	TArray<FASJournalName> PendingNames;
+	FCriticalSection PendingNamesLock;
+
+	TMap<FObjectKey, uint32> ActorIds;
+	TMap<FObjectKey, uint32> ClassIds;
+
+	/** Used by the flush task only */
+	TUniquePtr<FArchive> Writer;
+	TArray<FASJournalRecord> WriteBuffer;
+
+	UE::Tasks::FTask FlushTask;
+
+	FString FilePath;
+	float FlushAccumulator = 0.0f;
+
+	/** Records rejected because the ring buffer was full */
+	int64 DroppedRecords = 0;
+};
+
+/**
+ * @brief Records a journal event of an actor. Does nothing while no world is recording.
+ */
+#define AS_JOURNAL_RECORD(Actor, Type, Class, Value) \
+	do \
+	{ \
+		if (UASJournalSubsystem::IsAnyRecording()) \
+		{ \
+			UASJournalSubsystem::RecordEvent((Actor), EASJournalRecordType::Type, (Class), (Value)); \
+		} \
+	} while (0)
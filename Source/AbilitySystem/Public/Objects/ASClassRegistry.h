@@ -0,0 +1,60 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @class FASClassRegistry
+ * @brief Compact IDs of effect, attribute and ability classes.
+ *
+ * Built once the engine has been initialized from the native classes and the Blueprint classes known to the
+ * asset registry, without loading them. Classes are sorted by path, so server and clients running the same
+ * build get the same IDs. The checksum of the table tells whether two machines agree on them.
+ *
+ * IDs start at 1 and are dense, so they can index arrays instead of hashing class pointers.
+ *
+ * @note IDs change with content, store class paths in anything that outlives the build (see FASSnapshotClassTable).
+ */
+class ABILITYSYSTEM_API FASClassRegistry
+{
+public:
+	/** Id of classes which are not in the table */
+	static constexpr uint16 InvalidId = 0;
+
+	/**
+	 * @brief Rebuilds the table (game thread).
+	 *
+	 * @note IDs of loaded classes may change, only call it before any world is created.
+	 */
+	static void Build();
+
+	/**
+	 * @brief Gets the ID of a class or InvalidId if it was created after the table (e.g. a new Blueprint).
+	 *
+	 * The result is cached per class object, only the first lookup of a class builds its path.
+	 */
+	static uint16 GetId(const UClass* InClass);
+
+	/**
+	 * @brief Gets a class by ID, loading it if needed.
+	 *
+	 * @return Class or nullptr if the ID is invalid or the class failed to load.
+	 */
+	static UClass* GetClass(uint16 InId);
+
+	/**
+	 * @brief Gets the number of classes in the table.
+	 */
+	static int32 Num();
+
+	/**
+	 * @brief Gets the CRC of all class paths in ID order.
+	 */
+	static uint32 GetChecksum();
+
+	/**
+	 * @brief Prints every class with its ID.
+	 */
+	static void Dump(FOutputDevice& Ar);
+};
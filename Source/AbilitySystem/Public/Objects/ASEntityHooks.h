@@ -0,0 +1,51 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @enum EASEntityHooks
+ * @brief Notification events of attributes and effects called by UASComponent.
+ */
+enum class EASEntityHooks : uint8
+{
+	None = 0,
+	AttributeListUpdated = 1 << 0,
+	AttributeAdded = 1 << 1,
+	AttributeRemoving = 1 << 2,
+	EffectListUpdated = 1 << 3,
+	EffectAdded = 1 << 4,
+	EffectRemoving = 1 << 5,
+	All = AttributeListUpdated | AttributeAdded | AttributeRemoving | EffectListUpdated | EffectAdded | EffectRemoving,
+};
+
+ENUM_CLASS_FLAGS(EASEntityHooks);
+
+/**
+ * @class FASEntityHooks
+ * @brief Per-class cache of implemented notification events.
+ *
+ * Events of a class are looked up once:
+ * - Blueprint classes implement an event if they override it.
+ * - Native classes of this plugin implement none.
+ * - Other native classes report their events via UBasicAsEntity::GetNativeEntityHooks (all by default).
+ *
+ * UASComponent skips events a class does not implement, so plain entities cost no ProcessEvent calls.
+ */
+class ABILITYSYSTEM_API FASEntityHooks
+{
+public:
+	/**
+	 * @brief Gets the events implemented by the class (game thread).
+	 */
+	static EASEntityHooks Get(const UClass* InClass);
+
+	/**
+	 * @brief Drops all cached classes.
+	 */
+	static void Reset();
+
+private:
+	static EASEntityHooks Compute(const UClass* InClass);
+};
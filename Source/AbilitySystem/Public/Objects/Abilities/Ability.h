@@ -0,0 +1,219 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Objects/BasicAsEntity.h"
+#include "Ability.generated.h"
+
+class UAttribute;
+class UASComponent;
+
+/**
+ * @struct FASAbilityCost
+ * @brief Amount of an attribute consumed by an ability activation.
+ */
+USTRUCT(BlueprintType)
+struct ABILITYSYSTEM_API FASAbilityCost
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Attribute to pay with. The owning component must have it.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Ability|Cost")
+	TSubclassOf<UAttribute> Attribute;
+
+	/**
+	 * @brief Amount subtracted from the current value on activation.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Ability|Cost", meta=(UIMin="0", ClampMin="0"))
+	float Amount = 0.0f;
+};
+
+/**
+ * @struct FASAbilityActivationRequest
+ * @brief Client request to activate an ability, sent to the server in batches.
+ *
+ * Serialized into 3 bytes.
+ *
+ * @see UASComponent::RequestActivateAbility
+ */
+USTRUCT()
+struct ABILITYSYSTEM_API FASAbilityActivationRequest
+{
+	GENERATED_BODY()
+
+	/** Index of the ability in the replicated ability list of the component */
+	UPROPERTY()
+	uint8 AbilityIndex = 0;
+
+	/** Client generated key, returned to the client if the request is rejected */
+	UPROPERTY()
+	uint16 PredictionKey = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template <>
+struct TStructOpsTypeTraits<FASAbilityActivationRequest> : public TStructOpsTypeTraitsBase2<FASAbilityActivationRequest>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * @class UAbility
+ * @brief Represents an action the owner can activate, paid with attributes and limited by a cooldown.
+ *
+ * The cooldown is stored as the server time it ends at, no timer is started for it.
+ * It is the only replicated runtime state of the ability, so clients check the cooldown
+ * and costs locally and CanActivate costs a couple of comparisons per call.
+ *
+ * Abilities are owned and replicated by UASComponent.
+ *
+ * @see UASComponent::AddAbility
+ * @see UASComponent::TryActivateAbility
+ */
+UCLASS(Abstract, Blueprintable, BlueprintType)
+class ABILITYSYSTEM_API UAbility : public UBasicAsEntity
+{
+	GENERATED_BODY()
+
+public:
+	UAbility(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+protected:
+	/**
+	 * @brief Attributes consumed by every activation.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Ability")
+	TArray<FASAbilityCost> Costs;
+
+	/**
+	 * @brief Time in seconds after an activation before the ability can be activated again.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Ability", meta=(UIMin="0", ClampMin="0"))
+	float Cooldown;
+
+	/**
+	 * @brief Server world time the current cooldown ends at, 0 if the ability has never been activated.
+	 *
+	 * @note The variable must be changed via StartCooldown or ResetCooldown, otherwise replication will not work
+	 */
+	UPROPERTY(BlueprintReadOnly, Category="Ability", ReplicatedUsing=OnRep_CooldownEndTime)
+	double CooldownEndTime;
+
+	/** Attributes of Costs, resolved once per change of the owning component attribute list */
+	UPROPERTY(Transient)
+	mutable TArray<UAttribute*> CostAttributes;
+
+	/** UASComponent::GetAttributeListVersion CostAttributes were resolved for */
+	mutable uint32 CostAttributesVersion;
+
+protected:
+	UFUNCTION()
+	virtual void OnRep_CooldownEndTime();
+
+	/**
+	 * @brief Gets attributes of Costs in the same order, null entries are missing attributes.
+	 */
+	const TArray<UAttribute*>& GetCostAttributes() const;
+
+public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual FString GetDebugString_Implementation() const override;
+	virtual void SerializeSnapshot(FArchive& Ar) override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+public:
+	/**
+	 * @brief Checks whether the ability is ready and the owner can pay for it.
+	 *
+	 * Works on server and clients, does not allocate.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Ability|Getters")
+	virtual bool CanActivate() const;
+
+	/**
+	 * @brief Checks whether the owning component has enough of every cost attribute.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Ability|Getters")
+	virtual bool CanPayCosts() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Ability|Getters")
+	bool IsOnCooldown() const;
+
+	/**
+	 * @return Time left until the ability is ready, 0 if it is ready.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Ability|Getters")
+	float GetCooldownRemaining() const;
+
+	/**
+	 * @return Elapsed part of the cooldown in [0, 1], 1 if the ability is ready.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Ability|Getters")
+	float GetCooldownProgress() const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Ability|Getters")
+	FORCEINLINE float GetCooldown() const { return Cooldown; }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Ability|Getters")
+	FORCEINLINE double GetCooldownEndTime() const { return CooldownEndTime; }
+
+	/**
+	 * @brief Gets Owner Component by class
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Ability|Getters")
+	virtual UASComponent* GetOwningComponent() const;
+
+public:
+	/**
+	 * @brief Checks, pays costs, starts the cooldown and activates the ability.
+	 *
+	 * @return True if the ability has been activated.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Ability|Main")
+	virtual bool TryActivate();
+
+	/**
+	 * @brief Subtracts all costs from the owning component attributes.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Ability|Main")
+	virtual void CommitCosts();
+
+	/**
+	 * @brief Starts the cooldown from the current server time.
+	 *
+	 * @param InCooldown Length of the cooldown, uses Cooldown if negative.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Ability|Main")
+	virtual void StartCooldown(float InCooldown = -1.0f);
+
+	/**
+	 * @brief Makes the ability ready right away.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Ability|Main")
+	virtual void ResetCooldown();
+
+	/**
+	 * @brief The main logic of the ability, called after costs are paid and the cooldown is started.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category="Ability|Main")
+	void Activate();
+
+	/**
+	 * @brief Called when the ability is removed from the component.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category="Ability|Main")
+	void OnRemoved();
+
+	/**
+	 * @brief Called on clients when the replicated cooldown has changed.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category="Ability|Main")
+	void OnCooldownUpdated();
+};
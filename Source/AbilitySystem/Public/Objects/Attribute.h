@@ -13,6 +13,28 @@ class UEffect;
 class UASComponent;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAttributeValueDelegate, UAttribute*, AttributePtr, float, Value);
 
+DECLARE_MULTICAST_DELEGATE_TwoParams(FASAttributeValueNativeEvent, UAttribute*, float);
+
+/**
+ * @struct FASAttributeNativeEvents
+ * @brief Native counterparts of UAttribute delegates, allocated on first use.
+ */
+struct FASAttributeNativeEvents
+{
+	FASAttributeValueNativeEvent MinValueChanged;
+	FASAttributeValueNativeEvent MaxValueChanged;
+	FASAttributeValueNativeEvent ValueChanged;
+	FASAttributeValueNativeEvent ValueMinThresholdReached;
+	FASAttributeValueNativeEvent ValueMaxThresholdReached;
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return MinValueChanged.GetAllocatedSize() + MaxValueChanged.GetAllocatedSize() +
+			ValueChanged.GetAllocatedSize() + ValueMinThresholdReached.GetAllocatedSize() +
+			ValueMaxThresholdReached.GetAllocatedSize();
+	}
+};
+
 /**
  * @class UAttribute
  * @brief A class that represents an attribute with a minimum, maximum, and current value, which can be replicated.
@@ -86,9 +108,20 @@ protected:
 	UFUNCTION()
 	virtual void OnRep_CurrentValue();
 
+public:
+	/**
+	 * @brief Broadcasts all value delegates once.
+	 *
+	 * Called on clients by the owning component after the initial state has been received,
+	 * instead of the individual replication notifies.
+	 */
+	virtual void NotifyInitialState();
+
 public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual FString GetDebugString_Implementation() const override;
+	virtual void SerializeSnapshot(FArchive& Ar) override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 
 public:
 	/**
@@ -240,4 +273,44 @@ public:
 	 */
 	UPROPERTY(BlueprintAssignable, Category="Attribute|Events")
 	FAttributeValueDelegate OnValueMaxThresholdReached;
+
+	/**
+	 * @brief Gets native events of the attribute, allocating them on first use.
+	 *
+	 * Native events are cheaper than the Blueprint delegates above and cost no memory until something binds.
+	 */
+	FASAttributeNativeEvents& GetNativeEvents();
+
+	FORCEINLINE bool HasNativeEvents() const { return NativeEvents.IsValid(); }
+
+protected:
+	/**
+	 * @brief Broadcasts a Blueprint delegate and its native counterpart, skipping the ones without listeners.
+	 */
+	FORCEINLINE void BroadcastEvent(FAttributeValueDelegate& InDelegate,
+	                                FASAttributeValueNativeEvent FASAttributeNativeEvents::*InNativeEvent,
+	                                float InValue)
+	{
+		if (InDelegate.IsBound())
+		{
+			InDelegate.Broadcast(this, InValue);
+		}
+		if (NativeEvents.IsValid())
+		{
+			(NativeEvents.Get()->*InNativeEvent).Broadcast(this, InValue);
+		}
+	}
+
+	/**
+	 * @brief Checks whether value listeners may be notified, bounds SetValue calls nested in listeners.
+	 *
+	 * @see UASComponent::MaxCascadeDepth
+	 */
+	bool CanNotifyValueChange() const;
+
+private:
+	TUniquePtr<FASAttributeNativeEvents> NativeEvents;
+
+	/** Number of value notifications in progress */
+	int32 ValueNotifyDepth = 0;
 };
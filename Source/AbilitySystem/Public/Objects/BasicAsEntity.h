@@ -4,8 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "Data/AdvancedReplicatedObject.h"
+#include "Objects/ASEntityHooks.h"
+#include "UObject/CoreNetTypes.h"
 #include "BasicAsEntity.generated.h"
 
+class UASComponent;
+class UActorChannel;
+class FOutBunch;
+struct FReplicationFlags;
+
 /**
  * @class UBasicAsEntity
  * @brief A base class for entities in the Ability System.
@@ -29,6 +36,69 @@ public:
 
 public:
 	virtual bool IsSupportedForNetworking() const override { return true; }
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+#if UE_WITH_IRIS
+	/**
+	 * @brief Creates Iris replication fragments from the replicated properties of the class.
+	 *
+	 * @note Only the entity is registered, its own nested subobjects are not replicated with Iris.
+	 */
+	virtual void RegisterReplicationFragments(UE::Net::FFragmentRegistrationContext& Context,
+	                                          UE::Net::EFragmentRegistrationFlags RegistrationFlags) override;
+#endif
+
+	/**
+	 * @brief Gets the condition the entity is replicated to a connection with.
+	 *
+	 * @see NetCondition
+	 */
+	virtual ELifetimeCondition GetNetCondition() const { return NetCondition; }
+
+	/**
+	 * @brief Replicates this entity and its own subobjects through the owning actor channel.
+	 *
+	 * Records bits written per class when 'as.NetStats.Enabled' is set.
+	 *
+	 * @return True if anything was written into the bunch.
+	 *
+	 * @see FASReplicationStats
+	 */
+	virtual bool ReplicateAsSubobject(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags);
+
+	/**
+	 * @brief Writes or reads the runtime state of the entity for component snapshots.
+	 *
+	 * @note Must read exactly what it writes. Overrides should call Super first.
+	 * Data added later must be guarded with ASSnapshot::GetVersion(Ar).
+	 *
+	 * @see UASComponent::SaveSnapshot
+	 */
+	virtual void SerializeSnapshot(FArchive& Ar);
+
+	/**
+	 * @brief Declares notification events overridden in C++ by classes outside of this plugin.
+	 *
+	 * Override it in native entity classes to skip events they do not implement.
+	 *
+	 * @see FASEntityHooks
+	 */
+	virtual EASEntityHooks GetNativeEntityHooks() const { return EASEntityHooks::All; }
+
+	/**
+	 * @brief Checks whether the class of the entity implements a notification event.
+	 *
+	 * UASComponent does not call events which are not implemented.
+	 */
+	FORCEINLINE bool HasEntityHook(EASEntityHooks InHook) const
+	{
+		if (!bEntityHooksCached)
+		{
+			EntityHooks = FASEntityHooks::Get(GetClass());
+			bEntityHooksCached = true;
+		}
+		return EnumHasAnyFlags(EntityHooks, InHook);
+	}
 
 	/**
 	 * @brief Retrieves a debug string representation of the object.
@@ -40,5 +110,49 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintPure, Category="Entity")
 	FString GetDebugString() const;
 
-	
+	/**
+	 * @brief Checks whether the net condition lets the entity replicate with the given flags (legacy replication).
+	 */
+	static bool PassesNetCondition(ELifetimeCondition InCondition, const FReplicationFlags& InRepFlags);
+
+protected:
+	/**
+	 * @brief Connections the entity replicates to, e.g. Owner Only for effects only their owner should know about.
+	 *
+	 * Applied by both the legacy replication and Iris. Conditions other than None, Owner Only, Skip Owner,
+	 * Simulated Only, Autonomous Only, Replay Only, Skip Replay and Never are treated as None.
+	 *
+	 * @note On connections the entity is not replicated to, the lists of the component contain null in its place.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category="Entity|Replication")
+	TEnumAsByte<ELifetimeCondition> NetCondition = COND_None;
+
+	/**
+	 * @brief Finds the ability system component of the owning actor.
+	 *
+	 * The result is cached, so repeated calls do not search actor components.
+	 */
+	UASComponent* FindOwningComponent() const;
+
+	/**
+	 * @brief Checks whether a replication notify should be held back.
+	 *
+	 * On clients the owning component holds back entity notifies until its initial state is complete,
+	 * then notifies everything in a single pass.
+	 *
+	 * @see UASComponent::DeferInitialRepNotify
+	 */
+	bool ShouldDeferRepNotify() const;
+
+	/**
+	 * @brief Gets the server world time, synchronized on clients.
+	 */
+	double GetServerWorldTime() const;
+
+private:
+	mutable TWeakObjectPtr<UASComponent> CachedOwningComponent;
+
+	/** Events implemented by the class, see HasEntityHook */
+	mutable EASEntityHooks EntityHooks = EASEntityHooks::None;
+	mutable bool bEntityHooksCached = false;
 };
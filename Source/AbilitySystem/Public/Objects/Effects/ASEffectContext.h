@@ -0,0 +1,37 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ASEffectContext.generated.h"
+
+class AActor;
+
+/**
+ * @struct FASEffectContext
+ * @brief Who has applied an effect and with what.
+ */
+USTRUCT(BlueprintType)
+struct ABILITYSYSTEM_API FASEffectContext
+{
+	GENERATED_BODY()
+
+	FASEffectContext() = default;
+
+	explicit FASEffectContext(AActor* InInstigator, UObject* InSource = nullptr)
+		: Instigator(InInstigator), Source(InSource)
+	{
+	}
+
+	/**
+	 * @brief Actor responsible for the effect, e.g. the player who has cast it.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Effect|Context")
+	AActor* Instigator = nullptr;
+
+	/**
+	 * @brief Object the effect comes from, e.g. a weapon or an ability.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Effect|Context")
+	UObject* Source = nullptr;
+};
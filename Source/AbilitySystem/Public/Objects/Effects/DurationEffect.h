@@ -25,6 +25,31 @@ public:
 	virtual void StartWork_Implementation() override;
 	virtual bool Stack_Implementation(UEffect* AnotherEffect) override;
 	virtual void OnWorkEnded_Implementation() override;
+	virtual void ResumeWork() override;
+	virtual void SerializeSnapshot(FArchive& Ar) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+protected:
+	UFUNCTION()
+	virtual void OnRep_Timing();
+
+	/**
+	* @brief Starts the duration timer with the given time left.
+	*/
+	virtual void StartDurationTimer(float InTime);
+
+	/**
+	* @brief Time left restored from a snapshot, negative if not restored.
+	*/
+	float RestoredRemainingTime{-1.0f};
+
+	/**
+	* @brief Start time and length of the current duration.
+	*
+	* Replicated when the effect is applied or refreshed, so clients can compute remaining time locally.
+	*/
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing=OnRep_Timing, Category="DurationEffect")
+	FASEffectTiming Timing;
 
 public:
 	/**
@@ -33,6 +58,28 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
 	virtual void RunTimer();
 
+	/**
+	* @brief Gets the time left until the effect ends.
+	*
+	* @return Remaining time in seconds, 0 if the timer is not running.
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="DurationEffect")
+	virtual float GetRemainingTime() const;
+
+	/**
+	* @brief Gets the elapsed part of the duration.
+	*
+	* @return Progress (0.0 - 1.0).
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="DurationEffect")
+	float GetDurationProgress() const;
+
+	/**
+	* @brief Called on the server and on clients when the duration has been (re)started.
+	*/
+	UFUNCTION(BlueprintNativeEvent, Category="DurationEffect")
+	void OnTimingUpdated();
+
 	/**
 	* @brief The duration of the effect in seconds.
 	*
@@ -55,5 +102,10 @@ public:
 	UPROPERTY(BlueprintReadOnly)
 	FTimerHandle TimerHandle;
 
+	/**
+	* @brief Handle of the duration timer when the owning component drives effect timers.
+	*/
+	FASEffectTimerHandle ScheduledTimerHandle;
+
 	virtual FString GetDebugString_Implementation() const override;
 };
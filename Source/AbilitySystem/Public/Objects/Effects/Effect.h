@@ -4,12 +4,55 @@
 
 #include "CoreMinimal.h"
 #include "Data/AdvancedReplicatedObject.h"
+#include "Formula/ASFormula.h"
 #include "Objects/BasicAsEntity.h"
+#include "Objects/Effects/ASEffectContext.h"
+#include "Time/ASEffectScheduler.h"
 #include "UObject/Object.h"
 #include "Effect.generated.h"
 
 class UAttribute;
 class UASComponent;
+struct FASAttributeWriteBuffer;
+
+/**
+ * @struct FASEffectTiming
+ * @brief Replicated start time and length of an effect timer.
+ *
+ * Sent once when the timer is (re)started, clients compute remaining time locally
+ * using the effect time of the owning component.
+ */
+USTRUCT(BlueprintType)
+struct ABILITYSYSTEM_API FASEffectTiming
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Effect time the timer was (re)started at.
+	 *
+	 * @see UASComponent::GetEffectTime
+	 */
+	UPROPERTY(BlueprintReadOnly, Category="Effect|Timing")
+	double StartTime = 0.0;
+
+	/**
+	 * @brief Length of the timer in seconds, 0 if the timer is not running.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category="Effect|Timing")
+	float Duration = 0.0f;
+
+	FORCEINLINE bool IsSet() const { return Duration > 0.0f; }
+
+	/**
+	 * @return Time left until StartTime + Duration.
+	 */
+	float GetRemaining(double InServerTime) const;
+
+	/**
+	 * @return Time left until the next multiple of Duration after StartTime (looping timers).
+	 */
+	float GetRemainingLooping(double InServerTime) const;
+};
 /**
  * @class UEffect
  * @brief Represents an instant effect that must be manually removed.
@@ -65,6 +108,79 @@ protected:
 	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category="Effect", ReplicatedUsing=OnRep_StackableNum)
 	int32 StackableNum{1};
 
+	/**
+	* @brief Whether periodic ticks are evaluated natively across worker threads.
+	*
+	* Periodic ticks of such effects are queued to UASParallelTickSubsystem, which calls EvaluatePeriodTick
+	* for all queued effects in parallel and applies the produced attribute writes on the game thread.
+	* PeriodTick is not called for such effects.
+	* Effects of components with a deterministic EffectTimeMode always tick serially.
+	*
+	* @note Only enable it for classes that implement EvaluatePeriodTick in C++ or use Magnitude.
+	*
+	* @see EvaluatePeriodTick
+	 */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category="Effect|Performance")
+	uint8 bParallelPeriodTick : 1;
+
+	/**
+	* @brief Importance of the effect when the component is over its budget.
+	*
+	* Effects of lower priority are evicted to make room for effects of higher priority.
+	*
+	* @see UASComponent::MaxEffects
+	 */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category="Effect")
+	int32 Priority{0};
+
+	/**
+	* @brief Level of the effect, usable in the magnitude formula.
+	*
+	* @note The variable must be changed via a setter, otherwise replication will not work
+	 */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category="Effect", Replicated)
+	int32 Level{1};
+
+	/**
+	* @brief Instigator and source the effect has been applied with, see UASComponent::AddEffect.
+	*
+	* @note Set once before StartWork, stacking keeps the context of the first application
+	 */
+	UPROPERTY(BlueprintReadOnly, Category="Effect", Replicated)
+	FASEffectContext Context;
+
+	/**
+	* @brief Native formula of the effect strength, e.g. "5 + Strength * 0.2 * Stacks".
+	*
+	* The formula is compiled once per class, attribute references are resolved once per attribute list
+	* of the owning component. Evaluation does not go through the Blueprint VM.
+	*
+	* @see ApplyMagnitude
+	 */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category="Effect|Magnitude")
+	FASFormula Magnitude;
+
+	/**
+	* @brief Attribute the magnitude is added to by ApplyMagnitude.
+	*
+	* Periodic effects apply the magnitude on every tick by default (also when bParallelPeriodTick is set).
+	 */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category="Effect|Magnitude")
+	TSubclassOf<UAttribute> MagnitudeTarget;
+
+	/**
+	* @brief Whether the magnitude is applied once when the effect starts.
+	 */
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category="Effect|Magnitude")
+	uint8 bApplyMagnitudeOnStart : 1;
+
+	/** Attributes of the magnitude formula followed by MagnitudeTarget, resolved for MagnitudeAttributesVersion */
+	UPROPERTY(Transient)
+	TArray<UAttribute*> MagnitudeAttributes;
+
+	/** UASComponent::GetAttributeListVersion MagnitudeAttributes were resolved for */
+	uint32 MagnitudeAttributesVersion;
+
 protected:
 	UFUNCTION()
 	virtual void OnRep_StackableNum();
@@ -73,8 +189,25 @@ public:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual void ObjectBeginPlay() override;
 	virtual FString GetDebugString_Implementation() const override;
+	virtual void SerializeSnapshot(FArchive& Ar) override;
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 protected:
+	/**
+	 * @brief Compiles the magnitude formula if needed and resolves its attributes (game thread).
+	 */
+	void PrepareMagnitude();
+
+	/**
+	 * @brief Evaluates the magnitude with already resolved attributes, safe on worker threads.
+	 */
+	float EvaluatePreparedMagnitude() const;
+
 	/**
 	 * @brief Manually notifies the end of the effect.
 	 * 
@@ -83,13 +216,125 @@ protected:
 	UFUNCTION(BlueprintCallable)
 	virtual void EndWork();
 
+	/**
+	 * @brief Queues the periodic tick to UASParallelTickSubsystem if bParallelPeriodTick is set.
+	 *
+	 * @return True if the tick was queued, false if it must be executed right away.
+	 */
+	bool QueueParallelPeriodTick();
+
 public:
+	/**
+	 * @brief Applies the queued parallel tick of the effect right away, if any.
+	 *
+	 * Called by the owning component before the effect is removed.
+	 */
+	void FlushQueuedPeriodTick();
+
+protected:
+
+	/**
+	 * @brief Gets the time effect timings are expressed in.
+	 *
+	 * @see UASComponent::GetEffectTime
+	 */
+	double GetEffectTime() const;
+
+	/**
+	 * @brief Gets effect seconds per world second, 0 while effects of the owning component are paused.
+	 */
+	float GetEffectTimeRate() const;
+
+	/**
+	 * @brief Fills replicated timing of a timer that has just been (re)started.
+	 *
+	 * @param OutTiming Timing to fill.
+	 * @param InLength Length of the timer.
+	 * @param InFirstDelay Time until the first callback, uses InLength if negative.
+	 */
+	void StartTiming(FASEffectTiming& OutTiming, float InLength, float InFirstDelay = -1.0f) const;
+
+	/**
+	 * @brief Starts a timer on the world timer manager or on the owning component scheduler.
+	 *
+	 * @see UASComponent::EffectTimeMode
+	 *
+	 * @param InOutWorldHandle Handle used with the world timer manager.
+	 * @param InOutScheduledHandle Handle used with the component scheduler.
+	 * @param InDelegate Callback to execute.
+	 * @param InRate Time between callbacks.
+	 * @param bInLoop Whether the timer repeats.
+	 * @param InFirstDelay Time until the first callback, uses InRate if negative.
+	 */
+	void SetEffectTimer(FTimerHandle& InOutWorldHandle, FASEffectTimerHandle& InOutScheduledHandle,
+	                    const FTimerDelegate& InDelegate, float InRate, bool bInLoop, float InFirstDelay = -1.0f);
+
+	/**
+	 * @brief Stops a timer started with SetEffectTimer.
+	 */
+	void ClearEffectTimer(FTimerHandle& InOutWorldHandle, FASEffectTimerHandle& InOutScheduledHandle);
+
+	/**
+	 * @return Time until the next callback of a timer started with SetEffectTimer, -1 if not active.
+	 */
+	float GetEffectTimerRemaining(const FTimerHandle& InWorldHandle,
+	                              const FASEffectTimerHandle& InScheduledHandle) const;
+
+public:
+	/**
+	 * @brief Evaluates a single periodic tick without side effects.
+	 *
+	 * Called from worker threads when bParallelPeriodTick is set. Implementations may only read
+	 * the state of attributes and effects and must express all changes as writes into OutWrites.
+	 * By default adds the magnitude to MagnitudeTarget.
+	 *
+	 * @param OutWrites Buffer to be filled with attribute changes.
+	 */
+	virtual void EvaluatePeriodTick(FASAttributeWriteBuffer& OutWrites) const;
+
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Effect|Stackable")
 	virtual void SetStackableNum(int32 InValue);
 
 	UFUNCTION(BlueprintCallable)
 	FORCEINLINE int32 GetStackableNum() const { return StackableNum; }
 
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Effect")
+	virtual void SetLevel(int32 InValue);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Effect|Getters")
+	FORCEINLINE int32 GetLevel() const { return Level; }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Effect|Getters")
+	FORCEINLINE int32 GetPriority() const { return Priority; }
+
+	/**
+	 * @brief Should be called by the component only, before the effect starts working.
+	 */
+	void SetContext(const FASEffectContext& InContext);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Effect|Getters")
+	FORCEINLINE FASEffectContext GetContext() const { return Context; }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Effect|Getters")
+	FORCEINLINE AActor* GetInstigator() const { return Context.Instigator; }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="Effect|Getters")
+	FORCEINLINE UObject* GetSource() const { return Context.Source; }
+
+	/**
+	 * @brief Evaluates the magnitude formula for the current stack count, level and attributes.
+	 *
+	 * @return Magnitude, 0 if the effect has no formula.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Effect|Magnitude")
+	float EvaluateMagnitude();
+
+	/**
+	 * @brief Adds the evaluated magnitude to the current value of MagnitudeTarget.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="Effect|Magnitude")
+	virtual void ApplyMagnitude();
+
 	/**
 	* @brief Called when Array of attributes has changed
 	*/
@@ -136,6 +381,27 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category="Effect|Main")
 	void StartWork();
 
+	/**
+	 * @brief Continues the work of an effect restored from a snapshot.
+	 *
+	 * Called instead of `StartWork()`: the effect must restart its timers from the restored state,
+	 * but must not apply itself again (attributes are restored as well).
+	 *
+	 * @see UASComponent::RestoreSnapshot
+	 */
+	virtual void ResumeWork();
+
+	/**
+	 * @brief Called on clients when the time scale or the pause state of the owning component has changed.
+	 */
+	virtual void OnEffectClockChanged();
+
+	/**
+	 * @brief Called on clients when the effect has left the replicated list of the owning component
+	 * or the component has ended play. Local timers should be cleared here, not when the effect is destroyed.
+	 */
+	virtual void OnRemovedOnClient();
+
 	/**
 	 * @brief Marks the end of the effect's work.
 	 * 
@@ -31,6 +31,53 @@ protected:
 	*/
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly)
 	virtual void ClearPeriodicTimer();
+
+	/**
+	* @brief Starts the periodic timer.
+	*
+	* @param InFirstDelay Time until the first tick, uses Period if negative.
+	*/
+	virtual void StartPeriodicTimer(float InFirstDelay);
+
+	/**
+	* @brief Time until the next tick restored from a snapshot, negative if not restored.
+	*/
+	float RestoredTimeUntilTick{-1.0f};
+
+	/**
+	* @brief Phase and length of the periodic timer.
+	*
+	* Replicated when the periodic timer is (re)started, so clients can compute tick progress locally.
+	*/
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing=OnRep_PeriodTiming, Category="PeriodicEffect")
+	FASEffectTiming PeriodTiming;
+
+	UFUNCTION()
+	virtual void OnRep_PeriodTiming();
+
+	/**
+	* @brief Client: starts the local cosmetic timer aligned with the replicated period phase.
+	*/
+	virtual void RunCosmeticTimer();
+
+	/**
+	* @brief Client: stops the local cosmetic timer.
+	*/
+	virtual void ClearCosmeticTimer();
+
+	/**
+	* @brief Client: called by the local cosmetic timer.
+	*/
+	virtual void HandleCosmeticTimer();
+
+	/**
+	 * @brief Cosmetic-only periodic callback (pulse VFX, floating numbers, sounds).
+	 *
+	 * With bSimulateCosmeticTicks it runs on clients on a local schedule synchronized with the server ticks,
+	 * and right after PeriodTick on non-dedicated servers. It must never change gameplay state.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCosmetic, Category="PeriodicEffect|Cosmetic")
+	void CosmeticPeriodTick();
 	
 	/**
 	 * @brief Called periodically
@@ -38,12 +85,63 @@ protected:
 	 * The `PeriodTick` function is executed at regular intervals while the effect is active. It allows the developer
 	 * to define custom logic that should occur periodically, such as applying damage, healing, or other time-based effects.
 	 * This function is intended to be overridden in derived classes for specific behavior.
+	 * By default applies Magnitude to MagnitudeTarget.
 	 */
 	UFUNCTION(BlueprintNativeEvent)
 	void PeriodTick();
+
+	/**
+	 * @brief Called by the periodic timer, runs PeriodTick or queues a parallel evaluation.
+	 *
+	 * @see bParallelPeriodTick
+	 */
+	virtual void HandlePeriodicTimer();
 public:
 
 	virtual void StartWork_Implementation() override;
+	virtual void ResumeWork() override;
+	virtual void SerializeSnapshot(FArchive& Ar) override;
+
+	/**
+	* @brief Gets the time left until the next periodic tick.
+	*
+	* @return Time in seconds, 0 if the timer is not running.
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="PeriodicEffect")
+	virtual float GetTimeUntilNextTick() const;
+
+	/**
+	* @brief Gets the elapsed part of the current period.
+	*
+	* @return Progress (0.0 - 1.0).
+	*/
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category="PeriodicEffect")
+	float GetTickProgress() const;
+
+	/**
+	* @brief Called on the server and on clients when the periodic timer has been (re)started.
+	*/
+	UFUNCTION(BlueprintNativeEvent, Category="PeriodicEffect")
+	void OnPeriodTimingUpdated();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void OnEffectClockChanged() override;
+	virtual void OnRemovedOnClient() override;
+
+	/**
+	* @brief Whether CosmeticPeriodTick is simulated locally on clients.
+	*
+	* Clients schedule it from the replicated PeriodTiming without any additional traffic.
+	* Gameplay changes stay server-only in PeriodTick.
+	*/
+	UPROPERTY(BlueprintReadOnly, EditDefaultsOnly, Category="PeriodicEffect|Cosmetic")
+	uint8 bSimulateCosmeticTicks : 1;
+
+	/**
+	* @brief Client: handle of the local cosmetic timer.
+	*/
+	FTimerHandle CosmeticTimerHandle;
+	virtual void OnWorkEnded_Implementation() override;
 	virtual FString GetDebugString_Implementation() const override;
 	virtual void EndWork() override;
 	
@@ -66,4 +164,9 @@ public:
 	* This property is read-only and is used internally to track the timer's state.
 	*/
 	FTimerHandle PeriodicTimerHandle;
+
+	/**
+	* @brief Handle of the periodic timer when the owning component drives effect timers.
+	*/
+	FASEffectTimerHandle ScheduledPeriodicTimerHandle;
 };
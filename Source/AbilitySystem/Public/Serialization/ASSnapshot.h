@@ -0,0 +1,97 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @enum EASSnapshotVersion
+ * @brief Versions of the UASComponent binary snapshot format.
+ */
+enum class EASSnapshotVersion : uint16
+{
+	Initial = 1,
+
+	/** Abilities and their remaining cooldowns */
+	Abilities,
+
+	/** Level of effects */
+	EffectLevel,
+
+	// -----<new versions can be added above this line>-----
+	VersionPlusOne,
+	Latest = VersionPlusOne - 1
+};
+
+/**
+ * @class FASSnapshotClassTable
+ * @brief Table of entity classes referenced by a snapshot.
+ *
+ * Every class is stored once, entries reference it by a packed index.
+ */
+class ABILITYSYSTEM_API FASSnapshotClassTable
+{
+public:
+	/**
+	 * @brief Gets the index of a class, adding it to the table if needed (saving).
+	 */
+	uint32 FindOrAdd(UClass* InClass);
+
+	/**
+	 * @brief Gets a class by index (loading).
+	 *
+	 * @return Class or nullptr if the index is invalid or the class is not loaded.
+	 */
+	UClass* Get(uint32 InIndex) const;
+
+	/**
+	 * @brief Writes or reads the table.
+	 *
+	 * Classes are resolved among the loaded ones while reading, a snapshot never loads assets.
+	 */
+	void Serialize(FArchive& Ar);
+
+private:
+	TArray<UClass*> Classes;
+	TMap<UClass*, uint32> Indices;
+};
+
+namespace ASSnapshot
+{
+	/** Magic number at the start of every snapshot */
+	static constexpr uint32 Magic = 0x4E534153; // 'ASSN'
+
+	/** Upper bound of classes and of entries per entity list, larger counts are treated as corrupted data */
+	static constexpr uint32 MaxEntries = 4096;
+
+	/** Upper bound of a single entity payload in bytes */
+	static constexpr int32 MaxPayloadBytes = 64 * 1024;
+
+	/** Custom version key of entity payloads */
+	ABILITYSYSTEM_API extern const FGuid VersionGuid;
+
+	/**
+	 * @brief Sets the snapshot version of an entity payload archive.
+	 */
+	ABILITYSYSTEM_API void SetVersion(FArchive& Ar, EASSnapshotVersion InVersion);
+
+	/**
+	 * @brief Gets the snapshot version of an entity payload archive.
+	 *
+	 * @see UBasicAsEntity::SerializeSnapshot
+	 */
+	ABILITYSYSTEM_API EASSnapshotVersion GetVersion(const FArchive& Ar);
+
+	/**
+	 * @brief Writes the snapshot header.
+	 */
+	ABILITYSYSTEM_API void WriteHeader(FArchive& Ar);
+
+	/**
+	 * @brief Reads and validates the snapshot header.
+	 *
+	 * @param OutVersion Version of the snapshot.
+	 * @return False if the data is not a snapshot or the version is not supported.
+	 */
+	ABILITYSYSTEM_API bool ReadHeader(FArchive& Ar, EASSnapshotVersion& OutVersion);
+}
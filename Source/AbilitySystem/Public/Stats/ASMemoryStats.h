@@ -0,0 +1,28 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @class FASMemoryStats
+ * @brief Memory accounting helpers of the ability system.
+ *
+ * Sizes of components and entities are reported through UObject::GetResourceSizeEx,
+ * 'as.Memory.Report' prints them per component and per world.
+ */
+class ABILITYSYSTEM_API FASMemoryStats
+{
+public:
+	/**
+	 * @brief Estimates the replication shadow state kept for an object of the class.
+	 *
+	 * Sum of the sizes of replicated properties, cached per class (game thread).
+	 */
+	static SIZE_T GetReplicatedStateSize(const UClass* InClass);
+
+	/**
+	 * @brief Prints estimated memory of every ability system component, grouped by world.
+	 */
+	static void Report(FOutputDevice& Ar);
+};
@@ -0,0 +1,101 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * @struct FASReplicationStatEntry
+ * @brief Accumulated replication cost of a single entity class.
+ */
+struct ABILITYSYSTEM_API FASReplicationStatEntry
+{
+	/** Class path, cached at first record so the entry survives class unloading */
+	FString ClassName;
+
+	/** Total bits written into bunches by this class (subobject header + properties) */
+	int64 Bits = 0;
+
+	/** Number of replication passes in which this class actually wrote data */
+	int64 Updates = 0;
+
+	/** Number of replication passes this class took part in */
+	int64 Passes = 0;
+
+	/** Number of push model dirty marks, per replicated property */
+	TMap<FName, int64> PropertyUpdates;
+};
+
+/**
+ * @class FASReplicationStats
+ * @brief Per-class replication bandwidth accounting for ability system entities.
+ *
+ * Collects bits written per UBasicAsEntity subclass by UASComponent::ReplicateSubobjects
+ * and push model dirty marks per replicated property.
+ *
+ * @note Recording is disabled by default, enable it with 'as.NetStats.Enabled 1'.
+ * @note Results are available via 'as.NetStats.Dump', 'as.NetStats.Csv [FileName]' and 'as.NetStats.Reset'.
+ */
+class ABILITYSYSTEM_API FASReplicationStats
+{
+public:
+	static FASReplicationStats& Get();
+
+	/**
+	 * @brief Checks whether recording is enabled ('as.NetStats.Enabled').
+	 */
+	static bool IsEnabled();
+
+	/**
+	 * @brief Records a replication pass of an entity.
+	 *
+	 * @param InClass Class of the replicated entity.
+	 * @param InNumBits Bits written into the bunch during the pass.
+	 * @param bInWroteData Whether the entity had anything to send.
+	 */
+	void RecordReplication(const UClass* InClass, int64 InNumBits, bool bInWroteData);
+
+	/**
+	 * @brief Records a push model dirty mark of an entity property.
+	 *
+	 * @param InClass Class of the entity.
+	 * @param InPropertyName Name of the replicated property.
+	 */
+	void RecordPropertyUpdate(const UClass* InClass, FName InPropertyName);
+
+	/**
+	 * @brief Clears all recorded data.
+	 */
+	void Reset();
+
+	/**
+	 * @brief Prints a table sorted by bytes sent.
+	 */
+	void Dump(FOutputDevice& Ar) const;
+
+	/**
+	 * @brief Writes all recorded data as CSV.
+	 *
+	 * @param InFilePath Absolute path of the target file.
+	 * @return True if the file was written.
+	 */
+	bool WriteCsv(const FString& InFilePath) const;
+
+private:
+	FASReplicationStatEntry& FindOrAddEntry(const UClass* InClass);
+
+	TMap<FObjectKey, FASReplicationStatEntry> Entries;
+};
+
+/**
+ * @brief Records a push model dirty mark for net stats. Does nothing while recording is disabled.
+ */
+#define AS_RECORD_PROPERTY_UPDATE(ClassName, PropertyName, Object) \
+	do \
+	{ \
+		if (FASReplicationStats::IsEnabled()) \
+		{ \
+			FASReplicationStats::Get().RecordPropertyUpdate((Object)->GetClass(), GET_MEMBER_NAME_CHECKED(ClassName, PropertyName)); \
+		} \
+	} while (0)
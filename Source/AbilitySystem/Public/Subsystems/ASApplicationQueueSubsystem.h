@@ -0,0 +1,126 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Objects/Effects/ASEffectContext.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ASApplicationQueueSubsystem.generated.h"
+
+class UASComponent;
+class UEffect;
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FASApplicationBatchDelegate, int32, BatchId, int32, NumApplied);
+DECLARE_DELEGATE_TwoParams(FASApplicationBatchNativeDelegate, int32 /*BatchId*/, int32 /*NumApplied*/);
+
+/**
+ * @class UASApplicationQueueSubsystem
+ * @brief Applies large batches of effects over several frames within a per-frame time budget (server only).
+ *
+ * Batches are processed in priority order, batches of the same priority in the order they were queued.
+ * Every frame effects are added until 'as.ApplicationQueue.BudgetUs' microseconds are spent,
+ * at least one effect is added per frame so every batch eventually completes.
+ */
+UCLASS()
+class ABILITYSYSTEM_API UASApplicationQueueSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	/**
+	 * @brief Queues an effect for every target.
+	 *
+	 * @param Targets Components to add the effect to, destroyed ones are skipped.
+	 * @param EffectClass Class of the effect.
+	 * @param Priority Batches with higher priority are processed first.
+	 * @param OnCompleted Called once every target has been processed.
+	 * @param Context Instigator and source of the added effects.
+	 * @return Id of the batch or 0 if nothing has been queued.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects",
+		meta=(AutoCreateRefTerm="OnCompleted,Context"))
+	int32 QueueEffect(const TArray<UASComponent*>& Targets, TSubclassOf<UEffect> EffectClass, int32 Priority,
+	                  const FASApplicationBatchDelegate& OnCompleted, const FASEffectContext& Context);
+
+	/**
+	 * @brief Native version of QueueEffect.
+	 */
+	int32 QueueEffect(TArrayView<UASComponent* const> InTargets, TSubclassOf<UEffect> InEffectClass, int32 InPriority,
+	                  FASApplicationBatchNativeDelegate InOnCompleted = FASApplicationBatchNativeDelegate(),
+	                  const FASEffectContext& InContext = FASEffectContext());
+
+	/**
+	 * @brief Drops the remaining targets of a batch, its completion callback is not called.
+	 *
+	 * @return False if the batch has already completed.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects")
+	bool CancelBatch(int32 BatchId);
+
+	UFUNCTION(BlueprintPure, Category="AbilitySystem|Effects")
+	bool IsBatchPending(int32 BatchId) const;
+
+	/**
+	 * @brief Gets the number of targets not yet processed across all batches.
+	 */
+	UFUNCTION(BlueprintPure, Category="AbilitySystem|Effects")
+	int32 GetNumPending() const;
+
+	/**
+	 * @brief Processes all queued batches immediately, ignoring the budget.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects")
+	void Flush();
+
+private:
+	struct FBatch
+	{
+		int32 Id = 0;
+		int32 Priority = 0;
+		/** Kept alive by the subsystem until the batch completes, see AddReferencedObjects */
+		TObjectPtr<UClass> EffectClass;
+		TArray<TWeakObjectPtr<UASComponent>> Targets;
+
+		/** Context is not kept alive by the batch */
+		TWeakObjectPtr<AActor> Instigator;
+		TWeakObjectPtr<UObject> Source;
+
+		/** Index of the next target to process */
+		int32 Next = 0;
+
+		int32 NumApplied = 0;
+
+		FASApplicationBatchDelegate OnCompleted;
+		FASApplicationBatchNativeDelegate OnNativeCompleted;
+	};
+
+	FBatch* AddBatch(TSubclassOf<UEffect> InEffectClass, int32 InPriority);
+
+	/**
+	 * @brief Processes targets until the time limit is reached.
+	 *
+	 * @param InEndCycles Cycle count to stop at, 0 for no limit.
+	 */
+	void Process(uint64 InEndCycles);
+
+	/**
+	 * @brief Adds the effect to the next target of the first batch, completes the batch when it runs out of targets.
+	 */
+	void ProcessNext();
+
+	int32 FindBatchIndex(int32 InId) const;
+
+	/** Sorted by priority, highest first */
+	TArray<FBatch> Batches;
+
+	int32 LastBatchId = 0;
+};
@@ -0,0 +1,154 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "ASIndexSubsystem.generated.h"
+
+class UASComponent;
+class UAttribute;
+class UEffect;
+
+/**
+ * @class UASIndexSubsystem
+ * @brief World-wide reverse indices of ability system entities.
+ *
+ * Keeps every component which has begun play and maps effect and attribute classes to the components
+ * which have them, so e.g. finding every actor affected by a plague costs O(k) in the number of results.
+ * A class matches its subclasses, the same way UASComponent::HasEffect does.
+ * On the server it also maps instigators to the effects they have applied on any component of the world,
+ * so removing everything a dead player has applied costs O(k) in the number of their effects.
+ * Components keep the indices up to date when entities are added and removed.
+ */
+UCLASS()
+class ABILITYSYSTEM_API UASIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+#pragma region Components
+
+	void RegisterComponent(UASComponent* InComponent);
+	void UnregisterComponent(UASComponent* InComponent);
+
+	/**
+	 * @brief Adds a component to the index of an entity class and all its parent entity classes.
+	 */
+	void AddEntityClass(UASComponent* InComponent, const UClass* InClass);
+
+	/**
+	 * @brief Reverts AddEntityClass, a component stays indexed while it has other entities of the class.
+	 */
+	void RemoveEntityClass(UASComponent* InComponent, const UClass* InClass);
+
+	/**
+	 * @brief Gets all components of this world which have begun play.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem")
+	void GetComponents(TArray<UASComponent*>& OutComponents) const;
+
+	/**
+	 * @brief Gets all components which have an effect of the class.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Effects")
+	void GetComponentsWithEffect(TSubclassOf<UEffect> EffectClass, TArray<UASComponent*>& OutComponents) const;
+
+	UFUNCTION(BlueprintPure, Category="AbilitySystem|Effects")
+	int32 CountComponentsWithEffect(TSubclassOf<UEffect> EffectClass) const;
+
+	/**
+	 * @brief Gets all components which have an attribute of the class.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Attributes")
+	void GetComponentsWithAttribute(TSubclassOf<UAttribute> AttributeClass,
+	                                TArray<UASComponent*>& OutComponents) const;
+
+	UFUNCTION(BlueprintPure, Category="AbilitySystem|Attributes")
+	int32 CountComponentsWithAttribute(TSubclassOf<UAttribute> AttributeClass) const;
+
+	/**
+	 * @brief Calls a function for every component which has an entity of the class, without allocations.
+	 *
+	 * @note Components must not add or remove entities of the class from the function.
+	 */
+	void ForEachComponentWithClass(const UClass* InClass, TFunctionRef<void(UASComponent*)> InFunction) const;
+
+#pragma endregion
+
+#pragma region Instigators
+
+	/**
+	 * @brief Adds an active effect to the index of its instigator.
+	 *
+	 * @param InInstigator Key of the effect instigator, pass the same key to RemoveInstigatedEffect.
+	 */
+	void AddInstigatedEffect(UEffect* InEffect, FObjectKey InInstigator);
+
+	/**
+	 * @brief Removes an effect from the index of its instigator.
+	 *
+	 * @param InInstigator Key the effect was added under, valid even if the instigator has been destroyed.
+	 */
+	void RemoveInstigatedEffect(UEffect* InEffect, FObjectKey InInstigator);
+
+	/**
+	 * @brief Gets all active effects applied by an instigator in this world.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects")
+	void GetEffectsByInstigator(AActor* Instigator, TArray<UEffect*>& OutEffects) const;
+
+	/**
+	 * @brief Counts active effects applied by an instigator in this world.
+	 *
+	 * @param Instigator Instigator of the effects.
+	 * @param EffectClass Only effects of this class are counted, all if None.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects")
+	int32 CountEffectsByInstigator(AActor* Instigator, TSubclassOf<UEffect> EffectClass = nullptr) const;
+
+	/**
+	 * @brief Removes active effects applied by an instigator from all components of this world.
+	 *
+	 * @note Counts like UASComponent::RemoveEffectsByInstigator, deferred removals are not counted.
+	 *
+	 * @param Instigator Instigator of the effects.
+	 * @param EffectClass Only effects of this class are removed, all if None.
+	 * @return Number of effects removed by this call.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Effects")
+	int32 RemoveEffectsByInstigator(AActor* Instigator, TSubclassOf<UEffect> EffectClass = nullptr);
+
+#pragma endregion
+
+private:
+	/** Number of entities of a class, subclasses included, per component */
+	using FClassComponents = TMap<TWeakObjectPtr<UASComponent>, int32>;
+
+	const FClassComponents* FindClassComponents(const UClass* InClass) const;
+
+	FORCEINLINE FClassComponents* FindClassComponents(const UClass* InClass)
+	{
+		return const_cast<FClassComponents*>(AsConst(*this).FindClassComponents(InClass));
+	}
+
+	FClassComponents& FindOrAddClassComponents(const UClass* InClass);
+	void RemoveClassComponents(const UClass* InClass);
+
+	TSet<TWeakObjectPtr<UASComponent>> Components;
+
+	/** Classes of FASClassRegistry by ID */
+	TArray<FClassComponents> ComponentsByClassId;
+
+	/** Classes created after FASClassRegistry has been built */
+	TMap<FObjectKey, FClassComponents> ComponentsByClass;
+
+	TMap<FObjectKey, TArray<TWeakObjectPtr<UEffect>>> EffectsByInstigator;
+};
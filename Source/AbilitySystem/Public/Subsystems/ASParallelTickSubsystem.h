@@ -0,0 +1,103 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ASParallelTickSubsystem.generated.h"
+
+class UAttribute;
+class UEffect;
+
+/**
+ * @enum EASAttributeWriteOp
+ * @brief Operation of a deferred attribute write.
+ */
+enum class EASAttributeWriteOp : uint8
+{
+	/** Adds the value to the current value */
+	Add,
+
+	/** Replaces the current value, previous additions of the batch are discarded */
+	Set,
+};
+
+/**
+ * @struct FASAttributeWrite
+ * @brief A single deferred change of UAttribute current value.
+ */
+struct FASAttributeWrite
+{
+	UAttribute* Attribute = nullptr;
+	float Value = 0.0f;
+	EASAttributeWriteOp Op = EASAttributeWriteOp::Add;
+};
+
+/**
+ * @struct FASAttributeWriteBuffer
+ * @brief Attribute writes produced by an effect during parallel evaluation.
+ */
+struct ABILITYSYSTEM_API FASAttributeWriteBuffer
+{
+	FORCEINLINE void Add(UAttribute* InAttribute, float InDelta)
+	{
+		Writes.Add(FASAttributeWrite{InAttribute, InDelta, EASAttributeWriteOp::Add});
+	}
+
+	FORCEINLINE void Set(UAttribute* InAttribute, float InValue)
+	{
+		Writes.Add(FASAttributeWrite{InAttribute, InValue, EASAttributeWriteOp::Set});
+	}
+
+	TArray<FASAttributeWrite, TInlineAllocator<2>> Writes;
+};
+
+/**
+ * @class UASParallelTickSubsystem
+ * @brief Evaluates periodic ticks of native effects across worker threads.
+ *
+ * Effects with bParallelPeriodTick queue their ticks here instead of calling PeriodTick.
+ * Once per frame all queued ticks are evaluated with ParallelFor via UEffect::EvaluatePeriodTick,
+ * then the produced writes are merged per attribute and applied on the game thread,
+ * so every touched attribute is set (and broadcast) once per batch.
+ *
+ * @note Small batches are evaluated on the game thread ('as.ParallelTick.MinBatchSize').
+ */
+UCLASS()
+class ABILITYSYSTEM_API UASParallelTickSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	/**
+	 * @brief Queues a periodic tick of the effect for the next batch.
+	 *
+	 * @param InEffect Effect with bParallelPeriodTick.
+	 */
+	void QueuePeriodTick(UEffect* InEffect);
+
+	/**
+	 * @brief Evaluates all queued ticks and applies their writes immediately.
+	 */
+	void Flush();
+
+	/**
+	 * @brief Flushes the batch if it holds a tick of the effect, so the tick is not lost when the effect is removed.
+	 */
+	void FlushIfQueued(const UEffect* InEffect);
+
+protected:
+	/** Effects waiting for evaluation, in the order their timers fired */
+	TArray<TWeakObjectPtr<UEffect>> PendingTicks;
+
+	/** Effects of PendingTicks, for lookups on removal */
+	TSet<const UEffect*> QueuedEffects;
+};
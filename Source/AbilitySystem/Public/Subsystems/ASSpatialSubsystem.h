@@ -0,0 +1,196 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "Objects/Effects/ASEffectContext.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ASSpatialSubsystem.generated.h"
+
+class UASComponent;
+class UEffect;
+
+/**
+ * @enum EASTeamFilter
+ * @brief Team attitude of a target towards the instigator required by FASSpatialFilter.
+ */
+UENUM(BlueprintType)
+enum class EASTeamFilter : uint8
+{
+	/** Teams are ignored */
+	Any,
+
+	Friendly,
+	Neutral,
+	Hostile,
+
+	/** Neutral or hostile */
+	NotFriendly,
+};
+
+/**
+ * @struct FASSpatialFilter
+ * @brief Filter applied to components found by spatial queries.
+ */
+USTRUCT(BlueprintType)
+struct ABILITYSYSTEM_API FASSpatialFilter
+{
+	GENERATED_BODY()
+
+	/** Owner must have this actor tag, ignored if None */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter")
+	FName RequiredTag;
+
+	/** Owner must not have this actor tag, ignored if None */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter")
+	FName ExcludedTag;
+
+	/** Required attitude of the owner towards the instigator (IGenericTeamAgentInterface) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter")
+	EASTeamFilter Team = EASTeamFilter::Any;
+
+	/** Skip the component of the instigator itself */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Filter")
+	bool bExcludeInstigator = true;
+};
+
+/**
+ * @class UASSpatialSubsystem
+ * @brief Spatial hash of UASComponent owners for area queries and area-of-effect application.
+ *
+ * Components register themselves on BeginPlay (see UASComponent::bSpatialIndexed).
+ * Owners moving (root component TransformUpdated) only flag their entry, the first query of a frame
+ * rehashes the flagged entries, so a query costs the owners that moved and the cells it overlaps.
+ *
+ * @note Cell size is set by 'as.Spatial.CellSize', it should be close to the typical query radius.
+ */
+UCLASS()
+class ABILITYSYSTEM_API UASSpatialSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	void Register(UASComponent* InComponent);
+	void Unregister(UASComponent* InComponent);
+
+	/**
+	 * @brief Finds components whose owners are within a sphere.
+	 *
+	 * @param Center Center of the sphere.
+	 * @param Radius Radius of the sphere.
+	 * @param Filter Tag and team filter.
+	 * @param Instigator Actor the team attitude is evaluated against, may be null.
+	 * @param OutComponents Found components.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Spatial", meta=(AutoCreateRefTerm="Filter"))
+	void QueryRadius(FVector Center, float Radius, const FASSpatialFilter& Filter, AActor* Instigator,
+	                 TArray<UASComponent*>& OutComponents);
+
+	/**
+	 * @brief Finds components whose owners are within an axis-aligned box.
+	 *
+	 * @param Center Center of the box.
+	 * @param Extent Half size of the box.
+	 * @param Filter Tag and team filter.
+	 * @param Instigator Actor the team attitude is evaluated against, may be null.
+	 * @param OutComponents Found components.
+	 */
+	UFUNCTION(BlueprintCallable, Category="AbilitySystem|Spatial", meta=(AutoCreateRefTerm="Filter"))
+	void QueryBox(FVector Center, FVector Extent, const FASSpatialFilter& Filter, AActor* Instigator,
+	              TArray<UASComponent*>& OutComponents);
+
+	/**
+	 * @brief Adds an effect to every matching component within a sphere (server only).
+	 *
+	 * Stacking rules of UASComponent::AddEffect apply, so a periodic re-application
+	 * of a short duration effect keeps an aura on everyone in range.
+	 * Instigator is stored as the instigator of the added effects.
+	 *
+	 * @return Number of matching components that have the effect after the call.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Spatial",
+		meta=(AutoCreateRefTerm="Filter"))
+	int32 ApplyEffectInRadius(TSubclassOf<UEffect> EffectClass, FVector Center, float Radius,
+	                          const FASSpatialFilter& Filter, AActor* Instigator);
+
+	/**
+	 * @brief Adds an effect to every matching component within an axis-aligned box (server only).
+	 *
+	 * @return Number of matching components that have the effect after the call.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category="AbilitySystem|Spatial",
+		meta=(AutoCreateRefTerm="Filter"))
+	int32 ApplyEffectInBox(TSubclassOf<UEffect> EffectClass, FVector Center, FVector Extent,
+	                       const FASSpatialFilter& Filter, AActor* Instigator);
+
+	FORCEINLINE int32 Num() const { return Entries.Num() - FreeEntries.Num(); }
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UASComponent> Component;
+		FVector Location = FVector::ZeroVector;
+		FIntVector Cell = FIntVector::ZeroValue;
+
+		/** Root component of the owner the movement is tracked on */
+		TWeakObjectPtr<USceneComponent> Root;
+		FDelegateHandle MovedHandle;
+
+		/** Owner has moved since the last refresh, the entry is in DirtyEntries */
+		bool bDirty = false;
+	};
+
+	/**
+	 * @brief Moves flagged components to the cells of their current owner locations, once per frame.
+	 */
+	void Refresh();
+
+	/**
+	 * @brief Flags the entry of a moved owner for the next refresh.
+	 */
+	void OnOwnerMoved(USceneComponent* InRoot, EUpdateTransformFlags InFlags, ETeleportType InTeleport, int32 InIndex);
+
+	/**
+	 * @brief Frees the entry of a component (unregistered or destroyed without EndPlay).
+	 */
+	void ReleaseEntry(int32 InIndex);
+
+	/**
+	 * @brief Collects matching components of the cells overlapping the box.
+	 *
+	 * @param InContains Exact test of an owner location.
+	 */
+	void Query(const FBox& InBox, TFunctionRef<bool(const FVector&)> InContains, const FASSpatialFilter& InFilter,
+	           const AActor* InInstigator, TArray<UASComponent*>& OutComponents);
+
+	int32 ApplyEffect(TSubclassOf<UEffect> InEffectClass, TArrayView<UASComponent* const> InComponents,
+	                  const FASEffectContext& InContext);
+
+	bool PassesFilter(const UASComponent* InComponent, const FASSpatialFilter& InFilter,
+	                  const AActor* InInstigator) const;
+
+	FIntVector GetCell(const FVector& InLocation) const;
+
+	void AddToCell(int32 InIndex);
+	void RemoveFromCell(int32 InIndex);
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeEntries;
+
+	/** Entries whose owners have moved since the last refresh */
+	TArray<int32> DirtyEntries;
+	TMap<TWeakObjectPtr<UASComponent>, int32> Indices;
+	TMap<FIntVector, TArray<int32, TInlineAllocator<4>>> Cells;
+
+	/** Cell size the entries have been hashed with */
+	float CellSize = 0.0f;
+
+	uint64 LastRefreshFrame = MAX_uint64;
+};
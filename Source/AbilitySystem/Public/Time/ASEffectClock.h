@@ -0,0 +1,44 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ASEffectClock.generated.h"
+
+/**
+ * @struct FASEffectClock
+ * @brief Replicated mapping from server world time to the effect time of a component.
+ *
+ * Sent only when the time scale or the pause state changes, clients compute the effect time
+ * from the synchronized server time like they do for effect timings.
+ *
+ * @see UASComponent::GetEffectTime
+ */
+USTRUCT(BlueprintType)
+struct ABILITYSYSTEM_API FASEffectClock
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Server world time of the last change.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category="Effect|Clock")
+	double ServerTime = 0.0;
+
+	/**
+	 * @brief Effect time at ServerTime.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category="Effect|Clock")
+	double Time = 0.0;
+
+	/**
+	 * @brief Effect seconds per server second, 0 while paused.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category="Effect|Clock")
+	float Rate = 1.0f;
+
+	FORCEINLINE double GetTime(double InServerTime) const
+	{
+		return Time + (InServerTime - ServerTime) * Rate;
+	}
+};
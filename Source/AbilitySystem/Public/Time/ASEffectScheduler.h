@@ -0,0 +1,115 @@
+﻿// © Artem Podorozhko. All Rights Reserved. This project, including all associated assets, code, and content, is the property of Artem Podorozhko. Unauthorized use, distribution, or modification is strictly prohibited.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TimerManager.h"
+
+/**
+ * @struct FASEffectTimerHandle
+ * @brief Handle of a timer owned by FASEffectScheduler.
+ */
+struct ABILITYSYSTEM_API FASEffectTimerHandle
+{
+	uint64 Id = 0;
+
+	FORCEINLINE bool IsValid() const { return Id != 0; }
+	FORCEINLINE void Invalidate() { Id = 0; }
+};
+
+/**
+ * @class FASEffectScheduler
+ * @brief Deterministic timer queue for effects that are driven by their component.
+ *
+ * Works like FTimerManager, but time only moves when the owner calls AdvanceTo().
+ * Timers due at the same time fire in the order they were (re)scheduled, so the same
+ * sequence of inputs always produces the same sequence of callbacks.
+ *
+ * @note Looping timers are rescheduled relative to their previous due time and never drift.
+ */
+class ABILITYSYSTEM_API FASEffectScheduler
+{
+public:
+	/**
+	 * @brief Starts (or restarts) a timer.
+	 *
+	 * @param InOutHandle Handle to (re)use. Previous timer of this handle is cleared.
+	 * @param InDelegate Callback to execute.
+	 * @param InRate Time between callbacks, clamped to a small positive value.
+	 * @param bInLoop Whether the timer repeats.
+	 * @param InFirstDelay Time until the first callback, uses InRate if negative.
+	 */
+	void SetTimer(FASEffectTimerHandle& InOutHandle, const FTimerDelegate& InDelegate, float InRate, bool bInLoop,
+	              float InFirstDelay = -1.0f);
+
+	/**
+	 * @brief Stops a timer and invalidates the handle.
+	 */
+	void ClearTimer(FASEffectTimerHandle& InOutHandle);
+
+	bool IsTimerActive(const FASEffectTimerHandle& InHandle) const;
+
+	/**
+	 * @return Time until the next callback of the timer, -1 if the timer is not active.
+	 */
+	float GetTimerRemaining(const FASEffectTimerHandle& InHandle) const;
+
+	/**
+	 * @return Rate of the timer, -1 if the timer is not active.
+	 */
+	float GetTimerRate(const FASEffectTimerHandle& InHandle) const;
+
+	/**
+	 * @brief Moves the scheduler time forward and executes all due callbacks in order.
+	 *
+	 * @param InTime New scheduler time. Ignored if it is not ahead of the current time.
+	 */
+	void AdvanceTo(double InTime);
+
+	/**
+	 * @brief Removes all timers and rewinds the time.
+	 */
+	void Reset();
+
+	FORCEINLINE double GetTime() const { return Time; }
+	FORCEINLINE int32 Num() const { return Timers.Num(); }
+
+	SIZE_T GetAllocatedSize() const { return Timers.GetAllocatedSize() + Queue.GetAllocatedSize(); }
+
+private:
+	struct FTimer
+	{
+		FTimerDelegate Delegate;
+		double DueTime = 0.0;
+		float Rate = 0.0f;
+		uint64 Sequence = 0;
+		bool bLoop = false;
+	};
+
+	struct FQueueEntry
+	{
+		double DueTime = 0.0;
+		uint64 Sequence = 0;
+		uint64 Id = 0;
+	};
+
+	struct FQueueEntryPredicate
+	{
+		FORCEINLINE bool operator()(const FQueueEntry& A, const FQueueEntry& B) const
+		{
+			return A.DueTime < B.DueTime || (A.DueTime == B.DueTime && A.Sequence < B.Sequence);
+		}
+	};
+
+	void Enqueue(uint64 InId, FTimer& InTimer);
+
+	/** Active timers by id. Cleared timers leave stale queue entries which are skipped */
+	TMap<uint64, FTimer> Timers;
+
+	/** Min-heap ordered by due time, then by scheduling sequence */
+	TArray<FQueueEntry> Queue;
+
+	double Time = 0.0;
+	uint64 NextId = 1;
+	uint64 NextSequence = 1;
+};